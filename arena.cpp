@@ -0,0 +1,39 @@
+/*
+* File: arena.cpp
+* Per-frame bump allocator for Winter Survival ESP
+*/
+
+#include "arena.h"
+#include <algorithm>
+
+FrameArena::FrameArena(size_t initialBytes)
+    : block(new uint8_t[initialBytes]), capacity(initialBytes) {
+}
+
+void FrameArena::Reset() {
+    if (!overflow.empty()) {
+        // Room for the whole of the frame that overflowed, with headroom
+        size_t peak = used + spilled;
+        overflow.clear();
+        capacity = (std::max)(capacity * 2, peak + peak / 2);
+        block.reset(new uint8_t[capacity]);
+        growths++;
+    }
+    used = 0;
+    spilled = 0;
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = (uintptr_t)block.get();
+    uintptr_t aligned = (base + used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if (aligned + bytes <= base + capacity) {
+        used = aligned + bytes - base;
+        return (void*)aligned;
+    }
+
+    // Too big for what is left: a block of its own until the next Reset
+    overflow.emplace_back(new uint8_t[bytes + alignment]);
+    spilled += bytes + alignment;
+    uintptr_t start = (uintptr_t)overflow.back().get();
+    return (void*)((start + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
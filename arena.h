@@ -0,0 +1,44 @@
+/*
+* File: arena.h
+* Per-frame bump allocator for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Scratch memory for one frame: allocations bump a pointer and Reset frees
+// them all at once. A frame that outgrows the block spills into extra blocks;
+// the next Reset replaces everything with one block big enough for that frame,
+// so once the peak has been seen no frame touches the heap.
+class FrameArena {
+public:
+    explicit FrameArena(size_t initialBytes = 256 * 1024);
+
+    void Reset();
+
+    // Uninitialized storage; nothing is destroyed on Reset.
+    void* Allocate(size_t bytes, size_t alignment);
+
+    template<typename T>
+    T* Allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destroyed");
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    size_t Used() const { return used + spilled; }
+    size_t Capacity() const { return capacity; }
+    // Times Reset had to grow the block.
+    uint64_t Growths() const { return growths; }
+
+private:
+    std::unique_ptr<uint8_t[]> block;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t spilled = 0;  // bytes handed out from overflow blocks this frame
+    uint64_t growths = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> overflow;
+};
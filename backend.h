@@ -0,0 +1,60 @@
+/*
+* File: backend.h
+* Memory source interface behind MemoryReader for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct ReadRequest {
+    uintptr_t address;
+    void* buffer;
+    size_t size;
+    bool ok;
+};
+
+enum RegionProtect : uint32_t {
+    kProtectRead = 1 << 0,
+    kProtectWrite = 1 << 1,
+    kProtectExecute = 1 << 2,
+};
+
+struct MemoryRegion {
+    uintptr_t base;
+    size_t size;
+    uint32_t protect;
+    bool committed;
+};
+
+// Where MemoryReader gets its bytes from: a live process or a captured image.
+// Failed reads leave their destination zeroed, like Read<T> always did.
+class MemoryBackend {
+public:
+    virtual ~MemoryBackend() = default;
+
+    virtual bool Read(uintptr_t address, void* buffer, size_t size) = 0;
+
+    // Reads every request in as few round-trips as the backend allows and
+    // returns how many were read completely.
+    virtual size_t ReadBatch(ReadRequest* requests, size_t count) = 0;
+
+    // Region containing address, or the first one above it (VirtualQueryEx semantics).
+    virtual bool Query(uintptr_t address, MemoryRegion& region) = 0;
+
+    virtual uintptr_t ModuleBase(const char* moduleName) = 0;
+
+    // Pointer straight into backend-owned memory when the range is resident
+    // locally (snapshots), nullptr otherwise.
+    virtual const uint8_t* View(uintptr_t /*address*/, size_t /*size*/) { return nullptr; }
+
+    // Remote read calls issued so far, for comparing pipeline changes.
+    // Read may be called from several threads at once (parallel scans).
+    virtual uint64_t ReadCalls() const { return readCalls; }
+    virtual uint64_t ReadBytes() const { return readBytes; }
+
+protected:
+    std::atomic<uint64_t> readCalls{ 0 };
+    std::atomic<uint64_t> readBytes{ 0 };
+};
@@ -0,0 +1,105 @@
+/*
+* File: bench/live_bench.cpp
+* Cross-process read benchmark for Winter Survival ESP on Linux
+*
+* Attaches to a running target (the game, or bench/wss_target) by name the way
+* MemoryReader::Initialize does and measures single-read latency, batched read
+* throughput, and then the full sampling pipeline end to end.
+*
+*   live_bench [seconds=3]
+*/
+
+#include "../logger.h"
+#include "../memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point since) {
+    return std::chrono::duration<double>(Clock::now() - since).count();
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 3.0;
+    Logger::Start("live_bench.log");
+
+    MemoryReader memory;
+    auto attachStart = Clock::now();
+    if (!memory.Initialize()) {
+        printf("failed to attach, is the target running? (see live_bench.log)\n");
+        Logger::Stop();
+        return 1;
+    }
+    printf("attached and resolved UWorld in %.1f ms\n", Seconds(attachStart) * 1e3);
+
+    // Raw backend numbers, without the reader's line cache in front
+    MemoryBackend& backend = memory.Cache().Inner();
+    uintptr_t moduleBase = backend.ModuleBase(MemoryReader::kModuleName);
+
+    // One 8-byte read per round-trip
+    const int reads = 20000;
+    uint64_t value;
+    auto start = Clock::now();
+    for (int i = 0; i < reads; i++) backend.Read(moduleBase + (i % 512) * 8, &value, sizeof(value));
+    printf("single read      %8.2f us per 8-byte read\n", Seconds(start) * 1e6 / reads);
+
+    // Scattered small reads in batches, and one large contiguous read
+    for (size_t batch : { 64, 1024, 4096 }) {
+        std::vector<uint8_t> buffer(batch * 64);
+        std::vector<ReadRequest> requests(batch);
+        const int rounds = (int)(200000 / batch);
+        start = Clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < batch; i++)
+                requests[i] = { moduleBase + 0x1000 + ((i * 7919) % 16384) * 128, &buffer[i * 64], 64, false };
+            backend.ReadBatch(requests.data(), batch);
+        }
+        double elapsed = Seconds(start);
+        printf("batch of %-5zu   %8.3f us per request  %8.1f MB/s\n", batch,
+            elapsed * 1e6 / (rounds * batch), rounds * batch * 64 / elapsed / 1e6);
+    }
+
+    std::vector<uint8_t> block(1 << 20);
+    start = Clock::now();
+    for (int i = 0; i < 64; i++) backend.Read(moduleBase + 0x1000, block.data(), block.size());
+    printf("1 MiB read       %8.1f MB/s\n", 64.0 * block.size() / Seconds(start) / 1e6);
+
+    // The reader thread's sample, end to end
+    std::vector<double> frameTimes;
+    // Warm-up resolves the whole array, kResolveBudget actors a frame, so the
+    // first sample holds every drawable and ids line up slot by slot below
+    EntityStore first, current;
+    memory.GetObjects(first);
+    for (size_t resolved = MemoryReader::kResolveBudget; resolved <= memory.Entities().Size();
+        resolved += MemoryReader::kResolveBudget)
+        memory.GetObjects(first);
+    uint64_t calls = backend.ReadCalls(), bytes = backend.ReadBytes();
+    auto runStart = Clock::now();
+    while (Seconds(runStart) < seconds) {
+        start = Clock::now();
+        memory.GetObjects(current);
+        Matrix4 view = memory.GetViewMatrix();
+        frameTimes.push_back(Seconds(start) * 1e6);
+        (void)view;
+    }
+
+    // The target keeps its actors moving, so positions should differ from the first sample
+    size_t moved = 0;
+    for (size_t i = 0; i < current.Size() && i < first.Size(); i++) {
+        if (current.ids[i] == first.ids[i] && (current.x[i] != first.x[i] || current.y[i] != first.y[i])) moved++;
+    }
+
+    size_t frames = frameTimes.size();
+    std::sort(frameTimes.begin(), frameTimes.end());
+    printf("pipeline         %8.0f frames/s  p50 %.1f us  p99 %.1f us  %.1f calls/frame  %.1f KB/frame\n",
+        frames / Seconds(runStart), frameTimes[frames / 2], frameTimes[frames * 99 / 100],
+        (backend.ReadCalls() - calls) / (double)frames, (backend.ReadBytes() - bytes) / 1024.0 / frames);
+    printf("                 %zu objects, %zu moved since the first sample\n", current.Size(), moved);
+
+    Logger::Stop();
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+* File: bench/motion_bench.cpp
+* Motion prediction benchmark for Winter Survival ESP
+*
+* Simulates 1000 entities walking with piecewise-constant velocities and the
+* odd teleport, samples them at 20/30/60 Hz and renders at 144 Hz. Reports the
+* mean and 99th percentile distance from the true position for the held
+* sample and extrapolation, the distance from the position one sample interval
+* ago for interpolation (which draws that far behind on purpose), and the
+* predictor's cost per frame.
+*/
+
+#include "../motion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+struct Walker {
+    Vec3 position;
+    Vec3 velocity;
+};
+
+struct ErrorStats {
+    std::vector<float> errors;
+
+    void Add(const Vec3& a, const Vec3& b) {
+        float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        errors.push_back(sqrtf(dx * dx + dy * dy + dz * dz));
+    }
+
+    void Print(const char* name) {
+        std::sort(errors.begin(), errors.end());
+        double sum = 0;
+        for (float error : errors) sum += error;
+        printf("  %-12s mean %7.2f  p99 %8.2f\n", name, sum / errors.size(), errors[errors.size() * 99 / 100]);
+    }
+};
+
+int main() {
+    const size_t kEntities = 1000;
+    const double kSeconds = 20.0;
+    const double kRenderRate = 144.0;
+    const uint64_t kStart = 1000000000;  // predictor treats time 0 as unsampled
+
+    for (double sampleRate : { 20.0, 30.0, 60.0 }) {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> spread(-20000.0f, 20000.0f);
+        std::uniform_real_distribution<float> walk(-600.0f, 600.0f);  // cm/s, running speed
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        std::vector<Walker> walkers(kEntities);
+        for (Walker& walker : walkers) {
+            walker.position = { spread(rng), spread(rng), 0.0f };
+            walker.velocity = { walk(rng), walk(rng), 0.0f };
+        }
+
+        MotionPredictor extrapolate, interpolate;
+        MotionPredictor::Settings settings;
+        extrapolate.Configure(settings);
+        settings.mode = MotionPredictor::Mode::Interpolate;
+        interpolate.Configure(settings);
+
+        WorldSnapshot sample;
+        sample.entities.Resize(kEntities);
+        ErrorStats held, extrapolated, interpolated;
+        double predictSeconds = 0;
+        size_t frames = 0;
+
+        // Step the world at 1 kHz; sample and render when their clocks come due
+        const double dt = 0.001;
+        double nextSample = 0, nextFrame = 0;
+        std::vector<std::vector<Vec3>> history;
+        for (double t = 0; t < kSeconds; t += dt) {
+            for (Walker& walker : walkers) {
+                if (chance(rng) < dt * 0.5f) walker.velocity = { walk(rng), walk(rng), 0.0f };
+                if (chance(rng) < dt * 0.01f) walker.position = { spread(rng), spread(rng), 0.0f };
+                walker.position.x += walker.velocity.x * (float)dt;
+                walker.position.y += walker.velocity.y * (float)dt;
+            }
+            history.emplace_back(kEntities);
+            for (size_t i = 0; i < kEntities; i++) history.back()[i] = walkers[i].position;
+            uint64_t now = kStart + (uint64_t)(t * 1e9);
+
+            if (t >= nextSample) {
+                nextSample += 1.0 / sampleRate;
+                for (size_t i = 0; i < kEntities; i++) {
+                    sample.entities.ids[i] = (uint32_t)i + 1;
+                    sample.entities.SetPosition(i, walkers[i].position);
+                    sample.entities.sampleTimes[i] = now;
+                }
+                sample.timestamp = now;
+                sample.sequence++;
+            }
+
+            if (t >= nextFrame && t > 1.0) {
+                nextFrame += 1.0 / kRenderRate;
+                auto start = std::chrono::steady_clock::now();
+                const WorldSnapshot& ahead = extrapolate.Predict(sample, now);
+                predictSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                const WorldSnapshot& behind = interpolate.Predict(sample, now);
+                frames++;
+
+                size_t delayed = history.size() - 1 - (std::min)(history.size() - 1,
+                    (size_t)(interpolate.SampleInterval() / 1e9 / dt + 0.5));
+                for (size_t i = 0; i < kEntities; i++) {
+                    held.Add(sample.entities.Position(i), walkers[i].position);
+                    extrapolated.Add(ahead.entities.Position(i), walkers[i].position);
+                    interpolated.Add(behind.entities.Position(i), history[delayed][i]);
+                }
+            } else if (t >= nextFrame) {
+                nextFrame += 1.0 / kRenderRate;
+                extrapolate.Predict(sample, now);
+                interpolate.Predict(sample, now);
+            }
+            if (history.size() > 1000) history.erase(history.begin(), history.begin() + 500);
+        }
+
+        printf("%.0f Hz sampling, %.0f Hz rendering, error in units (%.1f us per extrapolated frame)\n",
+            sampleRate, kRenderRate, predictSeconds / frames * 1e6);
+        held.Print("held");
+        extrapolated.Print("extrapolated");
+        interpolated.Print("interpolated");
+    }
+    return 0;
+}
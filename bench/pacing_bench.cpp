@@ -0,0 +1,83 @@
+/*
+* File: bench/pacing_bench.cpp
+* Frame pacing jitter benchmark for Winter Survival ESP
+*
+* Runs a paced loop with a small simulated frame workload at 60/144/240 Hz and
+* reports how late each frame starts versus its target, for FramePacer's two
+* modes and for a plain relative sleep like the old Sleep(16) loop.
+*/
+
+#include "../framepacer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+static void Work(std::mt19937& rng) {
+    // 0.5 - 2 ms of CPU work, roughly one render + present
+    uint64_t until = FramePacer::Now() + 500000 + rng() % 1500000;
+    while (FramePacer::Now() < until) {
+    }
+}
+
+static int64_t Percentile(std::vector<int64_t> values, double percentile) {
+    size_t index = (size_t)(percentile / 100.0 * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void Report(const char* name, double rate, std::vector<int64_t> errors) {
+    printf("%-10s %6.0f Hz  p50 %8.1f us  p90 %8.1f us  p99 %8.1f us  max %8.1f us\n", name, rate,
+        Percentile(errors, 50) / 1e3, Percentile(errors, 90) / 1e3, Percentile(errors, 99) / 1e3,
+        *std::max_element(errors.begin(), errors.end()) / 1e3);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+
+    for (double rate : { 60.0, 144.0, 240.0 }) {
+        int frames = (int)(rate * seconds);
+        std::mt19937 rng(42);
+
+        // Baseline: work, then sleep a whole period, measured against the ideal schedule
+        {
+            std::vector<int64_t> errors;
+            uint64_t period = (uint64_t)(1e9 / rate);
+            uint64_t start = FramePacer::Now();
+            for (int i = 1; i <= frames; i++) {
+                Work(rng);
+                std::this_thread::sleep_for(std::chrono::nanoseconds(period));
+                errors.push_back((int64_t)(FramePacer::Now() - (start + i * period)));
+            }
+            // Drift accumulates, so report the per-frame delta instead
+            for (size_t i = errors.size() - 1; i > 0; i--) errors[i] -= errors[i - 1];
+            errors.erase(errors.begin());
+            Report("sleep", rate, errors);
+        }
+
+        for (auto mode : { FramePacer::Mode::TargetRate, FramePacer::Mode::LatestPossible }) {
+            FramePacer pacer;
+            pacer.Configure(rate, mode);
+            // Let the wake-up offset and work estimate settle
+            for (int i = 0; i < 30; i++) {
+                pacer.Wait();
+                Work(rng);
+            }
+            pacer.ResetStats();
+
+            for (int i = 0; i < frames; i++) {
+                pacer.Wait();
+                Work(rng);
+            }
+
+            std::vector<int64_t> errors;
+            for (double p : { 50.0, 90.0, 99.0, 100.0 }) errors.push_back(pacer.ErrorPercentile(p));
+            printf("%-10s %6.0f Hz  p50 %8.1f us  p90 %8.1f us  p99 %8.1f us  max %8.1f us  (wake offset %.0f us)\n",
+                mode == FramePacer::Mode::TargetRate ? "target" : "late", rate,
+                errors[0] / 1e3, errors[1] / 1e3, errors[2] / 1e3, errors[3] / 1e3, pacer.WakeOffset() / 1e3);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*
+* File: bench/projection_bench.cpp
+* Batch world-to-screen projection benchmark for Winter Survival ESP
+*
+* Projects 1k/10k/100k random points around the camera through the SIMD batch
+* path and through a per-point scalar loop, and reports points per second.
+*/
+
+#include "../projection.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Per-point reference, as Overlay::WorldToScreen did it
+static size_t ProjectOneByOne(const Matrix4& m, const ProjectionParams& params,
+    const std::vector<float>& xs, const std::vector<float>& ys, const std::vector<float>& zs,
+    float* screenX, float* screenY) {
+    size_t written = 0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        float cx = xs[i] * m.m[0][0] + ys[i] * m.m[1][0] + zs[i] * m.m[2][0] + m.m[3][0];
+        float cy = xs[i] * m.m[0][1] + ys[i] * m.m[1][1] + zs[i] * m.m[2][1] + m.m[3][1];
+        float cw = xs[i] * m.m[0][3] + ys[i] * m.m[1][3] + zs[i] * m.m[2][3] + m.m[3][3];
+        if (cw < params.nearW || fabsf(cx) > cw || fabsf(cy) > cw) continue;
+        screenX[written] = (cx / cw + 1.0f) * params.viewportWidth / 2;
+        screenY[written] = (-cy / cw + 1.0f) * params.viewportHeight / 2;
+        written++;
+    }
+    return written;
+}
+
+int main() {
+    // Camera at the origin looking down +z, 90 degree vertical fov, 16:9
+    Matrix4 projection = {};
+    float yScale = 1.0f / tanf(0.785398f);
+    projection.m[0][0] = yScale / (1920.0f / 1080.0f);
+    projection.m[1][1] = yScale;
+    projection.m[2][2] = 1000.0f / (1000.0f - 0.1f);
+    projection.m[2][3] = 1.0f;
+    projection.m[3][2] = -0.1f * projection.m[2][2];
+
+    ProjectionParams params;
+    params.viewportWidth = 1920.0f;
+    params.viewportHeight = 1080.0f;
+
+    for (size_t count : { 1000, 10000, 100000 }) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> spread(-500.0f, 500.0f);
+        std::vector<float> xs(count), ys(count), zs(count);
+        for (size_t i = 0; i < count; i++) {
+            xs[i] = spread(rng);
+            ys[i] = spread(rng);
+            zs[i] = spread(rng);
+        }
+        std::vector<float> screenX(count), screenY(count);
+        std::vector<uint32_t> indices(count);
+
+        using Clock = std::chrono::steady_clock;
+        int runs = (int)(20000000 / count);
+        size_t visible = 0;
+
+        auto start = Clock::now();
+        for (int run = 0; run < runs; run++)
+            visible = ProjectPoints(projection, params, xs.data(), ys.data(), zs.data(), count,
+                screenX.data(), screenY.data(), indices.data());
+        double batch = std::chrono::duration<double>(Clock::now() - start).count() / runs;
+
+        size_t reference = 0;
+        start = Clock::now();
+        for (int run = 0; run < runs; run++)
+            reference = ProjectOneByOne(projection, params, xs, ys, zs, screenX.data(), screenY.data());
+        double scalar = std::chrono::duration<double>(Clock::now() - start).count() / runs;
+
+        printf("%7zu points  batch %7.1f Mpts/s  scalar %7.1f Mpts/s  visible %zu/%zu\n",
+            count, count / batch / 1e6, count / scalar / 1e6, visible, reference);
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+* File: bench/replay_bench.cpp
+* Snapshot recording and replay benchmark for Winter Survival ESP
+*
+* Records sessions of synthetic worlds (1k to 100k actors, moving and with 1%
+* churn) sampled through MemoryReader, and reports bytes per frame before and
+* after compression, encode and decode speed, and the largest position error
+* the quantization introduced (at most half a step). The file is then replayed
+* unthrottled through the CPU side of Overlay::Render (frustum query, batch
+* projection, draw list) and frames/s are reported with and without decoding.
+* Sampling here runs unpaced, so small worlds outrun the writer thread and some
+* frames are dropped, as a real session would under a stalled disk.
+*/
+
+#include "synthworld.h"
+#include "../logger.h"
+#include "../lzblock.h"
+#include "../memory.h"
+#include "../projection.h"
+#include "../drawlist.h"
+#include "../recording.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const char* kPath = "replay_bench.wss";
+
+// Overlay::Render without the device: cull, project feet and heads, emit boxes
+struct RenderPath {
+    std::vector<uint32_t> candidates;
+    std::vector<float> pointsX, pointsY, pointsZ;
+    std::vector<float> screenX, screenY;
+    std::vector<uint32_t> screenIndices;
+    std::vector<uint32_t> footSlots, headSlots;
+    DrawList drawList;
+
+    size_t Render(const WorldSnapshot& world) {
+        drawList.Begin(1920.0f, 1080.0f);
+        Matrix4 viewProj = Multiply(world.view, world.projection);
+        ProjectionParams params;
+        params.viewportWidth = 1920.0f;
+        params.viewportHeight = 1080.0f;
+        params.guardBand = 1.5f;
+
+        const EntityStore& entities = world.entities;
+        world.index.Frustum(viewProj, params.guardBand, candidates);
+        size_t count = candidates.size();
+        pointsX.resize(count * 2);
+        pointsY.resize(count * 2);
+        pointsZ.resize(count * 2);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t entity = candidates[i];
+            pointsX[i] = pointsX[count + i] = entities.x[entity];
+            pointsY[i] = pointsY[count + i] = entities.y[entity];
+            pointsZ[i] = entities.z[entity];
+            pointsZ[count + i] = entities.z[entity] + entities.extents[entity].z;
+        }
+        screenX.resize(count * 2);
+        screenY.resize(count * 2);
+        screenIndices.resize(count * 2);
+        size_t visible = ProjectPoints(viewProj, params, pointsX.data(), pointsY.data(), pointsZ.data(), count * 2,
+            screenX.data(), screenY.data(), screenIndices.data());
+
+        footSlots.assign(count, UINT32_MAX);
+        headSlots.assign(count, UINT32_MAX);
+        for (size_t k = 0; k < visible; k++) {
+            uint32_t index = screenIndices[k];
+            if (index < count) footSlots[index] = (uint32_t)k;
+            else headSlots[index - count] = (uint32_t)k;
+        }
+
+        size_t drawn = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t entity = candidates[i];
+            if (!(entities.flags[entity] & kEntityValid) || footSlots[i] == UINT32_MAX || headSlots[i] == UINT32_MAX) continue;
+            float footY = screenY[footSlots[i]];
+            float headX = screenX[headSlots[i]];
+            float headY = screenY[headSlots[i]];
+            float height = fabsf(footY - headY);
+            float width = height * (entities.extents[entity].x / entities.extents[entity].z);
+            Vec4 color = entities.categories[entity] == ActorCategory::Survivor
+                ? Vec4{ 1.0f, 0.0f, 0.0f, 1.0f } : Vec4{ 0.0f, 1.0f, 0.0f, 1.0f };
+            drawList.AddBox(Vec2{ headX - width / 2, (std::min)(headY, footY) }, width, height, 2.0f, color);
+            drawn++;
+        }
+        return drawn;
+    }
+};
+
+int main(int argc, char** argv) {
+    size_t maxActors = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+    using Clock = std::chrono::steady_clock;
+    Logger::Start("replay_bench.log");
+
+    printf("%8s %-7s %6s %11s %11s %7s %10s %10s %8s %10s %10s %7s\n", "actors", "mode", "frames", "raw B/f", "file B/f",
+        "ratio", "enc MB/s", "dec MB/s", "max err", "decode f/s", "replay f/s", "drawn");
+
+    for (size_t actors : { 1000, 10000, 100000 }) {
+        if (actors > maxActors) break;
+
+        for (double churn : { 0.0, 0.01 }) {
+            auto owned = std::make_unique<SyntheticWorld>(actors);
+            SyntheticWorld* world = owned.get();
+            MemoryReader memory;
+            if (!memory.Initialize(std::move(owned))) {
+                printf("failed to initialize against the synthetic world\n");
+                return 1;
+            }
+
+            WorldSnapshot snapshot;
+            for (size_t resolved = 0; resolved <= actors; resolved += MemoryReader::kResolveBudget)
+                memory.GetObjects(snapshot.entities);
+
+            // The recorder writes the file as the reader thread would; a second
+            // codec pair times encoding and decoding and checks the round trip
+            SnapshotRecorder recorder;
+            if (!recorder.Start(kPath)) {
+                printf("failed to open %s\n", kPath);
+                return 1;
+            }
+            SnapshotCodec encoder, decoder;
+            WorldSnapshot decoded;
+            std::vector<uint8_t> raw, packed, unpacked;
+            double encodeSeconds = 0.0, decodeSeconds = 0.0;
+            uint64_t rawBytes = 0;
+            float maxError = 0.0f;
+            bool intact = true;
+
+            int frames = (int)(3000000 / actors);
+            if (frames < 60) frames = 60;
+            for (int frame = 0; frame < frames; frame++) {
+                world->Step(1.0f / 30.0f, churn);
+                memory.GetObjects(snapshot.entities);
+                snapshot.index.Build(snapshot.entities);
+                snapshot.view = memory.GetViewMatrix();
+                snapshot.projection = memory.GetProjectionMatrix();
+                snapshot.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now().time_since_epoch()).count();
+                snapshot.sequence = frame + 1;
+                recorder.Record(snapshot);
+
+                auto start = Clock::now();
+                encoder.Encode(snapshot, raw);
+                packed.resize(LzBound(raw.size()));
+                size_t packedSize = LzCompress(raw.data(), raw.size(), packed.data());
+                encodeSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+                rawBytes += raw.size();
+
+                start = Clock::now();
+                unpacked.resize(raw.size());
+                intact &= LzDecompress(packed.data(), packedSize, unpacked.data(), unpacked.size());
+                intact &= decoder.Decode(unpacked.data(), unpacked.size(), decoded);
+                decodeSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+                const EntityStore& a = snapshot.entities;
+                const EntityStore& b = decoded.entities;
+                intact &= a.Size() == b.Size() && memcmp(&snapshot.view, &decoded.view, sizeof(Matrix4)) == 0;
+                for (size_t i = 0; intact && i < a.Size(); i++) {
+                    intact &= a.ids[i] == b.ids[i] && a.categories[i] == b.categories[i] && a.flags[i] == b.flags[i];
+                    maxError = (std::max)(maxError, (std::max)(fabsf(a.x[i] - b.x[i]),
+                        (std::max)(fabsf(a.y[i] - b.y[i]), fabsf(a.z[i] - b.z[i]))));
+                }
+            }
+            recorder.Stop();
+            if (!intact) {
+                printf("round trip mismatch at %zu actors\n", actors);
+                return 1;
+            }
+
+            // Unthrottled replay: decode only, then decode and render
+            SnapshotPlayer player;
+            if (!player.Open(kPath)) {
+                printf("failed to reopen %s\n", kPath);
+                return 1;
+            }
+            WorldSnapshot replayed;
+            int replayedFrames = 0;
+            auto start = Clock::now();
+            while (player.Next(replayed)) replayedFrames++;
+            double decodeOnly = std::chrono::duration<double>(Clock::now() - start).count();
+
+            RenderPath render;
+            size_t drawn = 0;
+            player.Rewind();
+            start = Clock::now();
+            while (player.Next(replayed)) drawn = render.Render(replayed);
+            double replay = std::chrono::duration<double>(Clock::now() - start).count();
+
+            uint64_t recorded = recorder.Frames();
+            printf("%8zu %-7s %6d %11.0f %11.0f %6.1fx %10.0f %10.0f %8.3f %10.0f %10.0f %7zu",
+                actors, churn > 0 ? "churn" : "static", replayedFrames, recorder.RawBytes() / (double)recorded,
+                recorder.FileBytes() / (double)recorded, recorder.RawBytes() / (double)recorder.FileBytes(),
+                rawBytes / encodeSeconds / 1e6, rawBytes / decodeSeconds / 1e6, maxError,
+                replayedFrames / decodeOnly, replayedFrames / replay, drawn);
+            printf("   (%llu dropped, %.1f B/entity raw)\n", (unsigned long long)recorder.Dropped(),
+                recorder.RawBytes() / (double)recorded / (std::max)(snapshot.entities.Size(), (size_t)1));
+        }
+    }
+
+    remove(kPath);
+    Logger::Stop();
+    return 0;
+}
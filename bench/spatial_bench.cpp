@@ -0,0 +1,152 @@
+/*
+* File: bench/spatial_bench.cpp
+* Spatial index benchmark for Winter Survival ESP
+*
+* Builds the grid over 1k/10k/100k objects spread over a 40 km map and times
+* radius, frustum and nearest-N queries against a linear pass over the list,
+* checking that both agree.
+*/
+
+#include "../projection.h"
+#include "../spatial.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double Micros(Clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - since).count();
+}
+
+int main() {
+    // Camera at (0, 0, 200) looking down +x, z up, 90 degree fov, 16:9
+    Matrix4 view = {};
+    view.m[0][2] = 1.0f;
+    view.m[1][0] = 1.0f;
+    view.m[2][1] = 1.0f;
+    view.m[3][1] = -200.0f;
+    view.m[3][3] = 1.0f;
+    Matrix4 projection = {};
+    float yScale = 1.0f / tanf(0.785398f);
+    projection.m[0][0] = yScale / (1920.0f / 1080.0f);
+    projection.m[1][1] = yScale;
+    projection.m[2][2] = 1.0f;
+    projection.m[2][3] = 1.0f;
+    projection.m[3][2] = -0.1f;
+    Matrix4 viewProj = Multiply(view, projection);
+
+    ProjectionParams params;
+    params.viewportWidth = 1920.0f;
+    params.viewportHeight = 1080.0f;
+    params.guardBand = 1.5f;
+
+    printf("%8s %10s %14s %14s %14s %14s\n", "objects", "build us", "radius us", "linear us", "frustum us", "nearest16 us");
+
+    for (size_t count : { 1000, 10000, 100000 }) {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> spread(-2000000.0f, 2000000.0f), height(-500.0f, 500.0f);
+        EntityStore objects;
+        objects.Resize(count);
+        for (size_t i = 0; i < count; i++) {
+            objects.ids[i] = (uint32_t)i;
+            objects.SetPosition(i, { spread(rng), spread(rng), height(rng) });
+            objects.extents[i] = { 100.0f, 100.0f, 200.0f };
+            objects.categories[i] = ActorCategory::Survivor;
+            objects.flags[i] = kEntityValid;
+        }
+
+        SpatialGrid grid;
+        const int builds = 20;
+        auto start = Clock::now();
+        for (int i = 0; i < builds; i++) grid.Build(objects);
+        double buildUs = Micros(start) / builds;
+
+        // Radius: grid vs linear, 100 queries of 500 m
+        std::vector<uint32_t> found, expected;
+        double gridUs = 0.0, linearUs = 0.0;
+        for (int query = 0; query < 100; query++) {
+            Vec3 center = { spread(rng), spread(rng), 0.0f };
+            float radius = 50000.0f;
+
+            start = Clock::now();
+            grid.Radius(center, radius, found);
+            gridUs += Micros(start);
+
+            start = Clock::now();
+            expected.clear();
+            for (size_t i = 0; i < count; i++) {
+                float dx = objects.x[i] - center.x, dy = objects.y[i] - center.y, dz = objects.z[i] - center.z;
+                if (dx * dx + dy * dy + dz * dz <= radius * radius) expected.push_back((uint32_t)i);
+            }
+            linearUs += Micros(start);
+
+            std::sort(found.begin(), found.end());
+            if (found != expected) {
+                printf("radius query disagrees with the linear pass\n");
+                return 1;
+            }
+        }
+
+        // Frustum: every object whose feet and head both project must be a candidate
+        start = Clock::now();
+        grid.Frustum(viewProj, params.guardBand, found);
+        double frustumUs = Micros(start);
+
+        std::vector<float> xs(count * 2), ys(count * 2), zs(count * 2), sx(count * 2), sy(count * 2);
+        std::vector<uint32_t> visible(count * 2), feet(count, 0), heads(count, 0);
+        for (size_t i = 0; i < count; i++) {
+            xs[i] = xs[count + i] = objects.x[i];
+            ys[i] = ys[count + i] = objects.y[i];
+            zs[i] = objects.z[i];
+            zs[count + i] = objects.z[i] + objects.extents[i].z;
+        }
+        size_t projected = ProjectPoints(viewProj, params, xs.data(), ys.data(), zs.data(), count * 2, sx.data(), sy.data(), visible.data());
+        for (size_t k = 0; k < projected; k++) {
+            if (visible[k] < count) feet[visible[k]] = 1;
+            else heads[visible[k] - count] = 1;
+        }
+        std::vector<uint8_t> candidate(count, 0);
+        for (uint32_t index : found) candidate[index] = 1;
+        size_t drawn = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (!feet[i] || !heads[i]) continue;
+            drawn++;
+            if (!candidate[i]) {
+                printf("frustum query culled a visible object\n");
+                return 1;
+            }
+        }
+
+        // Nearest 16 to a few points vs a partial sort
+        double nearestUs = 0.0;
+        for (int query = 0; query < 100; query++) {
+            Vec3 point = { spread(rng), spread(rng), 0.0f };
+            start = Clock::now();
+            grid.Nearest(point, 16, found);
+            nearestUs += Micros(start);
+
+            auto distance = [&](uint32_t i) {
+                float dx = objects.x[i] - point.x, dy = objects.y[i] - point.y, dz = objects.z[i] - point.z;
+                return dx * dx + dy * dy + dz * dz;
+            };
+            expected.resize(count);
+            for (size_t i = 0; i < count; i++) expected[i] = (uint32_t)i;
+            std::partial_sort(expected.begin(), expected.begin() + 16, expected.end(),
+                [&](uint32_t a, uint32_t b) { return distance(a) < distance(b); });
+            for (size_t i = 0; i < 16; i++) {
+                if (distance(found[i]) != distance(expected[i])) {
+                    printf("nearest query disagrees with the linear pass\n");
+                    return 1;
+                }
+            }
+        }
+
+        printf("%8zu %10.1f %14.2f %14.2f %14.1f %14.2f   (%zu candidates, %zu drawn)\n", count, buildUs,
+            gridUs / 100, linearUs / 100, frustumUs, nearestUs / 100, grid.Size() ? (size_t)0 + candidate.size() - std::count(candidate.begin(), candidate.end(), 0) : 0, drawn);
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+* File: bench/synthworld.cpp
+* Synthetic game memory image for Winter Survival ESP benchmarks
+*/
+
+#include "synthworld.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+template<typename T>
+void Put(uint8_t* at, const T& value) {
+    memcpy(at, &value, sizeof(T));
+}
+
+// A few real-looking class names; most actors in a level are scenery
+const char* kNames[] = {
+    "BP_Survivor_C",
+    "BP_Animal_Wolf_C",
+    "BP_Animal_Deer_C",
+    "BP_Tree_Pine_C",
+    "BP_Rock_Large_C",
+    "BP_Campfire_C",
+    "BP_Loot_Crate_C",
+    "StaticMeshActor",
+};
+constexpr size_t kNameCount = sizeof(kNames) / sizeof(kNames[0]);
+constexpr size_t kNameStride = 256;
+
+size_t PickName(std::mt19937& rng) {
+    // ~10% survivors, ~20% animals, the rest scenery
+    uint32_t roll = rng() % 100;
+    if (roll < 10) return 0;
+    if (roll < 30) return 1 + roll % 2;
+    return 3 + roll % (kNameCount - 3);
+}
+
+}
+
+SyntheticWorld::SyntheticWorld(size_t actorCount, uint32_t seed)
+    : actorCount(actorCount), poolSize(actorCount + actorCount / 8 + 16), rng(seed) {
+    // Module: headers, code, data
+    Region header = { kModuleBase, kProtectRead, 0x1000, nullptr, std::vector<uint8_t>(0x1000, 0) };
+    Region code = { kModuleBase + 0x1000, kProtectRead | kProtectExecute, kCodeSize, nullptr, std::vector<uint8_t>(kCodeSize, 0xCC) };
+    Region data = { kModuleBase + 0x1000 + kCodeSize, kProtectRead | kProtectWrite, 0x1000, nullptr, std::vector<uint8_t>(0x1000, 0) };
+    uint32_t imageSize = (uint32_t)(0x2000 + kCodeSize);
+
+    uint8_t* pe = header.bytes.data();
+    pe[0] = 'M';
+    pe[1] = 'Z';
+    Put<uint32_t>(pe + 0x3C, 0x80);
+    memcpy(pe + 0x80, "PE\0\0", 4);
+    Put<uint16_t>(pe + 0x84, 0x8664);            // Machine
+    Put<uint16_t>(pe + 0x86, 2);                 // NumberOfSections
+    Put<uint32_t>(pe + 0x88, 0x5EED0000 + seed); // TimeDateStamp
+    Put<uint16_t>(pe + 0x94, 0xF0);              // SizeOfOptionalHeader
+    Put<uint32_t>(pe + 0x98 + 56, imageSize);    // SizeOfImage
+    uint8_t* sections = pe + 0x98 + 0xF0;
+    memcpy(sections, ".text", 5);
+    Put<uint32_t>(sections + 8, (uint32_t)kCodeSize);
+    Put<uint32_t>(sections + 12, 0x1000);
+    Put<uint32_t>(sections + 36, 0x60000020);
+    memcpy(sections + 40, ".data", 5);
+    Put<uint32_t>(sections + 48, 0x1000);
+    Put<uint32_t>(sections + 52, (uint32_t)(0x1000 + kCodeSize));
+    Put<uint32_t>(sections + 76, 0xC0000040);
+
+    // Filler with a realistic byte mix, then "mov rcx, [rip + GWorld]; test rcx, rcx"
+    // near the end so a scan has to cover most of the section
+    for (size_t i = 0; i < kCodeSize; i += 4) {
+        uint32_t r = rng();
+        if ((r & 3) == 0) code.bytes[i] = 0x48;
+        else if ((r & 3) == 1) code.bytes[i] = (uint8_t)(r >> 8);
+    }
+    for (size_t i = 0; i + 10 <= kCodeSize; i++) {
+        if (code.bytes[i] == 0x48 && code.bytes[i + 1] == 0x8B && code.bytes[i + 2] == 0x0D) code.bytes[i] = 0xCC;
+    }
+    uintptr_t uWorld = data.base + 0x100;
+    size_t at = kCodeSize - 0x4000;
+    uintptr_t instruction = code.base + at;
+    const uint8_t load[] = { 0x48, 0x8B, 0x0D, 0, 0, 0, 0, 0x48, 0x85, 0xC9 };
+    memcpy(&code.bytes[at], load, sizeof(load));
+    Put<int32_t>(&code.bytes[at + 3], (int32_t)(uWorld - (instruction + 7)));
+
+    // Heap: level, camera chain, names, actor array, actors, root components
+    uintptr_t level = kHeapBase;
+    uintptr_t gameInstance = level + 0x200;
+    uintptr_t playerController = gameInstance + 0x100;
+    uintptr_t cameraManager = playerController + 0x300;
+    uintptr_t names = cameraManager + 0x300;
+    arrayAddress = names + kNameCount * kNameStride;
+    actorsAddress = (arrayAddress + actorCount * sizeof(uintptr_t) + 0xF) & ~(uintptr_t)0xF;
+    rootsAddress = actorsAddress + poolSize * kActorSize;
+    size_t heapSize = (rootsAddress + poolSize * kRootSize - kHeapBase + 0xFFF) & ~(size_t)0xFFF;
+    Region heap = { kHeapBase, kProtectRead | kProtectWrite, heapSize, nullptr, std::vector<uint8_t>(heapSize, 0) };
+
+    regions.push_back(std::move(header));
+    regions.push_back(std::move(code));
+    regions.push_back(std::move(data));
+    regions.push_back(std::move(heap));
+    for (Region& region : regions) region.data = region.bytes.data();
+
+    Set(uWorld, WorldLayout::PersistentLevel, level);
+    Set(uWorld, WorldLayout::OwningGameInstance, gameInstance);
+    Set(gameInstance, GameInstanceLayout::PlayerController, playerController);
+    Set(playerController, PlayerControllerLayout::PlayerCameraManager, cameraManager);
+
+    // View matrix for a camera at (0, 0, 500) looking down +X, z up (row vectors, LH)
+    Matrix4 view = {};
+    view.m[0][2] = 1.0f;
+    view.m[1][0] = 1.0f;
+    view.m[2][1] = 1.0f;
+    view.m[3][1] = -500.0f;
+    view.m[3][3] = 1.0f;
+    Set(cameraManager, CameraManagerLayout::ViewMatrix, view);
+
+    for (size_t i = 0; i < kNameCount; i++)
+        memcpy(At(names + i * kNameStride, kNameStride), kNames[i], strlen(kNames[i]) + 1);
+
+    std::uniform_real_distribution<float> spread(-20000.0f, 20000.0f), speed(-300.0f, 300.0f);
+    velocities.resize(poolSize);
+    drawable.resize(poolSize);
+    for (uint32_t i = 0; i < poolSize; i++) {
+        size_t name = PickName(rng);
+        drawable[i] = name < 3;
+        Set(ActorAddress(i), ActorLayout::Name, names + name * kNameStride);
+        Set(ActorAddress(i), ActorLayout::RootComponent, RootAddress(i));
+        Vec3 position = { spread(rng), spread(rng), 0.0f };
+        Set(RootAddress(i), SceneComponentLayout::RelativeLocation, position);
+        velocities[i] = name < 3 ? Vec3{ speed(rng), speed(rng), 0.0f } : Vec3{ 0.0f, 0.0f, 0.0f };
+    }
+
+    slots.resize(poolSize);
+    for (uint32_t i = 0; i < poolSize; i++) slots[i] = i;
+    std::shuffle(slots.begin(), slots.end(), rng);
+    for (size_t i = 0; i < actorCount; i++)
+        Put<uintptr_t>(At(arrayAddress + i * sizeof(uintptr_t), 8), ActorAddress(slots[i]));
+
+    Set(level, LevelLayout::ActorData, arrayAddress);
+    Set(level, LevelLayout::ActorCount, (int32_t)actorCount);
+    Set(level, LevelLayout::ActorMax, (int32_t)actorCount);
+}
+
+uint8_t* SyntheticWorld::At(uintptr_t address, size_t size) {
+    for (Region& region : regions) {
+        if (address >= region.base && address + size <= region.base + region.size)
+            return region.data + (address - region.base);
+    }
+    return nullptr;
+}
+
+void SyntheticWorld::Host(size_t index, uint8_t* memory) {
+    Region& region = regions[index];
+    if (memory != region.data) memcpy(memory, region.data, region.size);
+    region.data = memory;
+    std::vector<uint8_t>().swap(region.bytes);
+}
+
+void SyntheticWorld::Step(float seconds, double churn) {
+    for (size_t i = 0; i < actorCount; i++) {
+        uint32_t actor = slots[i];
+        const Vec3& velocity = velocities[actor];
+        if (velocity.x == 0.0f && velocity.y == 0.0f) continue;
+
+        Vec3* position = (Vec3*)At(RootAddress(actor) + SceneComponentLayout::RelativeLocation.offset, sizeof(Vec3));
+        position->x += velocity.x * seconds;
+        position->y += velocity.y * seconds;
+    }
+
+    size_t spares = poolSize - actorCount;
+    size_t swaps = (size_t)(churn * actorCount + 0.5);
+    for (size_t n = 0; n < swaps && spares; n++) {
+        size_t entry = rng() % actorCount;
+        size_t spare = actorCount + rng() % spares;
+        std::swap(slots[entry], slots[spare]);
+        Put<uintptr_t>(At(arrayAddress + entry * sizeof(uintptr_t), 8), ActorAddress(slots[entry]));
+    }
+}
+
+size_t SyntheticWorld::DrawableCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < actorCount; i++) count += drawable[slots[i]];
+    return count;
+}
+
+bool SyntheticWorld::Read(uintptr_t address, void* buffer, size_t size) {
+    readCalls++;
+    readBytes += size;
+    readRequests++;
+    const uint8_t* data = At(address, size);
+    if (data) {
+        memcpy(buffer, data, size);
+        return true;
+    }
+    memset(buffer, 0, size);
+    return false;
+}
+
+size_t SyntheticWorld::ReadBatch(ReadRequest* requests, size_t count) {
+    size_t succeeded = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* data = At(requests[i].address, requests[i].size);
+        requests[i].ok = data != nullptr;
+        if (data) memcpy(requests[i].buffer, data, requests[i].size);
+        else memset(requests[i].buffer, 0, requests[i].size);
+        readBytes += requests[i].size;
+        succeeded += requests[i].ok;
+    }
+    readCalls += (count + kBatchLimit - 1) / kBatchLimit;
+    readRequests += count;
+    return succeeded;
+}
+
+bool SyntheticWorld::Query(uintptr_t address, MemoryRegion& region) {
+    for (const Region& candidate : regions) {
+        if (address < candidate.base + candidate.size) {
+            region = { candidate.base, candidate.size, candidate.protect, true };
+            return true;
+        }
+    }
+    return false;
+}
+
+uintptr_t SyntheticWorld::ModuleBase(const char* /*moduleName*/) {
+    return kModuleBase;
+}
@@ -0,0 +1,85 @@
+/*
+* File: bench/synthworld.h
+* Synthetic game memory image for Winter Survival ESP benchmarks
+*/
+
+#pragma once
+#include "../backend.h"
+#include "../schema.h"
+#include "../types.h"
+#include <random>
+#include <vector>
+
+// Lays out the object graph MemoryReader walks, at the offsets in schema.h:
+//   module: PE headers, code containing the GWorld load, UWorld in .data
+//   UWorld -> ULevel -> actor array -> actors -> names and root components
+//   UWorld -> GameInstance -> PlayerController -> CameraManager -> view matrix
+// and serves it as a MemoryBackend, so the whole read pipeline runs unchanged.
+class SyntheticWorld : public MemoryBackend {
+public:
+    static constexpr uintptr_t kModuleBase = 0x140000000ull;
+    static constexpr uintptr_t kHeapBase = 0x200000000ull;
+    static constexpr size_t kCodeSize = 4 << 20;
+
+    // spare actors sit outside the array and are swapped in by Step's churn
+    explicit SyntheticWorld(size_t actorCount, uint32_t seed = 1);
+
+    // Moves every actor by its velocity and replaces churn (0..1) of the
+    // array's entries with actors that were not in it.
+    void Step(float seconds, double churn = 0.0);
+
+    size_t ActorCount() const { return actorCount; }
+    // Actors the classifier should keep (survivors and animals) currently in the array
+    size_t DrawableCount() const;
+
+    // Read requests served, next to ReadCalls' round-trips
+    uint64_t ReadRequests() const { return readRequests; }
+
+    struct Region {
+        uintptr_t base;
+        uint32_t protect;
+        size_t size;
+        uint8_t* data;
+        std::vector<uint8_t> bytes;  // storage until the region is hosted
+    };
+    const std::vector<Region>& Regions() const { return regions; }
+
+    // Moves a region's bytes to memory (e.g. mapped at region.base in a stand-in
+    // target) and keeps updating them there.
+    void Host(size_t index, uint8_t* memory);
+
+    bool Read(uintptr_t address, void* buffer, size_t size) override;
+    // Counted like the Linux live backend: one round-trip per IOV_MAX (1024) requests
+    size_t ReadBatch(ReadRequest* requests, size_t count) override;
+    bool Query(uintptr_t address, MemoryRegion& region) override;
+    uintptr_t ModuleBase(const char* moduleName) override;
+
+private:
+    static constexpr size_t kActorSize = 0x140;
+    static constexpr size_t kRootSize = 0x130;
+    static constexpr size_t kBatchLimit = 1024;
+    static_assert(ActorLayout::kSpan.begin + ActorLayout::kSpan.size <= kActorSize, "actor layout outgrew kActorSize");
+    static_assert(SceneComponentLayout::RelativeLocation.offset + sizeof(Vec3) <= kRootSize, "root layout outgrew kRootSize");
+
+    std::vector<Region> regions;  // sorted by base
+    size_t actorCount;
+    size_t poolSize;              // actors including spares
+    std::vector<uint32_t> slots;  // actor index held by each array entry, then the spares
+    std::vector<Vec3> velocities;
+    std::vector<uint8_t> drawable;
+    std::mt19937 rng;
+    std::atomic<uint64_t> readRequests{ 0 };
+
+    uintptr_t arrayAddress = 0;
+    uintptr_t actorsAddress = 0;
+    uintptr_t rootsAddress = 0;
+
+    uint8_t* At(uintptr_t address, size_t size);
+
+    template<typename T>
+    void Set(uintptr_t object, Field<T> field, const T& value) {
+        memcpy(At(object + field.offset, sizeof(T)), &value, sizeof(T));
+    }
+    uintptr_t ActorAddress(uint32_t index) const { return actorsAddress + index * kActorSize; }
+    uintptr_t RootAddress(uint32_t index) const { return rootsAddress + index * kRootSize; }
+};
@@ -0,0 +1,107 @@
+/*
+* File: bench/world_bench.cpp
+* Read pipeline scaling benchmark for Winter Survival ESP
+*
+* Runs MemoryReader against synthetic worlds of 100 to 100k actors and reports
+* frames/s, remote round-trips, read requests and bytes, and heap allocations
+* per frame (one frame = GetObjects + GetViewMatrix, as on the reader thread),
+* and the share of cacheable reads the line cache served locally. "alloc frms"
+* counts frames that allocated at all; static worlds should show none.
+* "static" only moves actors; "churn" also replaces 1% of the array per frame.
+* Positions are refreshed within the default read budget, so requests per frame
+* level off once the drawable count passes it.
+*/
+
+#include "synthworld.h"
+#include "../logger.h"
+#include "../memory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocations{ 0 };
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = malloc(size ? size : 1)) return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+
+int main(int argc, char** argv) {
+    size_t maxActors = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+    using Clock = std::chrono::steady_clock;
+    Logger::Start("world_bench.log");
+
+    printf("%8s %-7s %7s %10s %10s %10s %10s %11s %12s %10s %6s %8s\n", "actors", "mode", "frames", "frames/s", "us/frame",
+        "calls/f", "requests/f", "KB/frame", "allocs/f", "alloc frms", "hit%", "drawn");
+
+    for (size_t actors : { 100, 1000, 10000, 100000 }) {
+        if (actors > maxActors) break;
+
+        for (double churn : { 0.0, 0.01 }) {
+            auto owned = std::make_unique<SyntheticWorld>(actors);
+            SyntheticWorld* world = owned.get();
+
+            MemoryReader memory;
+            auto initStart = Clock::now();
+            if (!memory.Initialize(std::move(owned))) {
+                printf("failed to initialize against the synthetic world\n");
+                return 1;
+            }
+            double initMs = std::chrono::duration<double, std::milli>(Clock::now() - initStart).count();
+
+            // Warm-up resolves the whole array, kResolveBudget actors a frame,
+            // plus one frame for the frame arena to settle at its peak size;
+            // later frames are steady state
+            EntityStore entities;
+            for (size_t resolved = 0; resolved <= actors; resolved += MemoryReader::kResolveBudget)
+                memory.GetObjects(entities);
+            memory.GetObjects(entities);
+            int frames = (int)(300000 / actors);
+            if (frames < 30) frames = 30;
+
+            uint64_t calls = world->ReadCalls();
+            uint64_t requests = world->ReadRequests();
+            uint64_t bytes = world->ReadBytes();
+            uint64_t allocs = 0;
+            int allocatingFrames = 0;
+            double seconds = 0.0;
+            memory.Cache().ResetStats();
+            for (int frame = 0; frame < frames; frame++) {
+                world->Step(1.0f / 60.0f, churn);
+
+                uint64_t allocsBefore = allocations.load(std::memory_order_relaxed);
+                auto start = Clock::now();
+                memory.GetObjects(entities);
+                Matrix4 view = memory.GetViewMatrix();
+                seconds += std::chrono::duration<double>(Clock::now() - start).count();
+                uint64_t frameAllocs = allocations.load(std::memory_order_relaxed) - allocsBefore;
+                allocs += frameAllocs;
+                allocatingFrames += frameAllocs != 0;
+                (void)view;
+            }
+
+            PageCache& cache = memory.Cache();
+            double hitRate = 100.0 * cache.Hits() / (double)((std::max)(cache.Hits() + cache.Misses(), (uint64_t)1));
+            printf("%8zu %-7s %7d %10.0f %10.1f %10.1f %10.1f %11.1f %12.1f %10d %6.1f %8zu", actors, churn > 0 ? "churn" : "static",
+                frames, frames / seconds, seconds * 1e6 / frames, (world->ReadCalls() - calls) / (double)frames,
+                (world->ReadRequests() - requests) / (double)frames, (world->ReadBytes() - bytes) / 1024.0 / frames,
+                allocs / (double)frames, allocatingFrames, hitRate, entities.Size());
+            printf("   (init %.1f ms, %zu drawable)\n", initMs, world->DrawableCount());
+        }
+    }
+
+    Logger::Stop();
+    return 0;
+}
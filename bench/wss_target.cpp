@@ -0,0 +1,119 @@
+/*
+* File: bench/wss_target.cpp
+* Stand-in target process for Winter Survival ESP on Linux
+*
+* Hosts a SyntheticWorld at its real addresses: the module is a file mapping
+* named like the game executable (so /proc/<pid>/maps lists it) and the heap
+* is an anonymous mapping. Actors keep moving at the given tick rate until
+* SIGINT/SIGTERM or the optional duration runs out.
+*
+*   wss_target [actors=1000] [hz=60] [churn=0] [seconds=0 (forever)]
+*/
+
+#include "synthworld.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+static volatile std::sig_atomic_t running = 1;
+
+static void OnSignal(int) {
+    running = 0;
+}
+
+// Maps exactly at address or fails; the image's pointers are absolute
+static uint8_t* MapAt(uintptr_t address, size_t size, int fd) {
+    int flags = MAP_PRIVATE | (fd < 0 ? MAP_ANONYMOUS : 0);
+#ifdef MAP_FIXED_NOREPLACE
+    flags |= MAP_FIXED_NOREPLACE;
+#endif
+    void* mapped = mmap((void*)address, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (mapped == MAP_FAILED) return nullptr;
+    if ((uintptr_t)mapped != address) {
+        munmap(mapped, size);
+        return nullptr;
+    }
+    return (uint8_t*)mapped;
+}
+
+int main(int argc, char** argv) {
+    size_t actors = argc > 1 ? (size_t)atol(argv[1]) : 1000;
+    double rate = argc > 2 ? atof(argv[2]) : 60.0;
+    double churn = argc > 3 ? atof(argv[3]) : 0.0;
+    double duration = argc > 4 ? atof(argv[4]) : 0.0;
+    if (rate <= 0) rate = 60.0;
+
+    // Named like the game (the kernel keeps 15 chars), and readable by any
+    // same-user process even under Yama ptrace_scope=1
+    prctl(PR_SET_NAME, "WSS-Win64-Shipping.exe");
+#ifdef PR_SET_PTRACER
+    prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY);
+#endif
+
+    SyntheticWorld world(actors);
+    const std::vector<SyntheticWorld::Region>& regions = world.Regions();
+
+    // Header, code and data are contiguous; write them out as the module file
+    char directory[] = "/tmp/wss_target.XXXXXX";
+    if (!mkdtemp(directory)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    std::string path = std::string(directory) + "/WSS-Win64-Shipping.exe";
+    size_t moduleSize = regions[2].base + regions[2].size - regions[0].base;
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        perror("open");
+        return 1;
+    }
+    for (size_t i = 0; i < 3; i++) {
+        if (pwrite(fd, regions[i].data, regions[i].size, (off_t)(regions[i].base - regions[0].base)) != (ssize_t)regions[i].size) {
+            perror("pwrite");
+            return 1;
+        }
+    }
+
+    uint8_t* module = MapAt(regions[0].base, moduleSize, fd);
+    uint8_t* heap = MapAt(regions[3].base, regions[3].size, -1);
+    close(fd);
+    if (!module || !heap) {
+        fprintf(stderr, "failed to map the synthetic image at its fixed addresses\n");
+        unlink(path.c_str());
+        rmdir(directory);
+        return 1;
+    }
+
+    for (size_t i = 0; i < 3; i++) world.Host(i, module + (regions[i].base - regions[0].base));
+    world.Host(3, heap);
+    mprotect(module, regions[0].size, PROT_READ);
+    mprotect(module + regions[0].size, regions[1].size, PROT_READ | PROT_EXEC);
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+    printf("pid %d hosting %zu actors (%zu drawable) at %.0f Hz\n", (int)getpid(), actors, world.DrawableCount(), rate);
+    fflush(stdout);
+
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+    auto start = Clock::now();
+    auto next = start;
+    while (running) {
+        world.Step((float)(1.0 / rate), churn);
+
+        next += period;
+        std::this_thread::sleep_until(next);
+        if (duration > 0 && Clock::now() - start > std::chrono::duration<double>(duration)) break;
+    }
+
+    unlink(path.c_str());
+    rmdir(directory);
+    return 0;
+}
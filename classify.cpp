@@ -0,0 +1,104 @@
+/*
+* File: classify.cpp
+* Actor class categories and per-actor classification cache for Winter Survival ESP
+*/
+
+#include "classify.h"
+#include <cstring>
+
+namespace {
+
+struct ClassKey {
+    const char* key;
+    size_t length;
+    ActorCategory category;
+};
+
+constexpr size_t Length(const char* text) {
+    size_t length = 0;
+    while (text[length]) length++;
+    return length;
+}
+
+constexpr ClassKey kClassKeys[] = {
+    { "BP_Survivor", Length("BP_Survivor"), ActorCategory::Survivor },
+    { "BP_Animal", Length("BP_Animal"), ActorCategory::Animal },
+};
+constexpr size_t kClassKeyCount = sizeof(kClassKeys) / sizeof(kClassKeys[0]);
+
+constexpr uint32_t Hash(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    return hash;
+}
+
+constexpr size_t kTableSize = 16;
+
+constexpr size_t Slot(const char* text, size_t length) {
+    return Hash(text, length) & (kTableSize - 1);
+}
+
+struct ClassTable {
+    int8_t slots[kTableSize];
+};
+
+constexpr ClassTable BuildTable() {
+    ClassTable table = {};
+    for (size_t i = 0; i < kTableSize; i++) table.slots[i] = -1;
+    for (size_t i = 0; i < kClassKeyCount; i++) table.slots[Slot(kClassKeys[i].key, kClassKeys[i].length)] = (int8_t)i;
+    return table;
+}
+
+constexpr ClassTable kClassTable = BuildTable();
+
+// Every key must own its slot; grow kTableSize if a new key collides
+constexpr bool IsPerfect() {
+    for (size_t i = 0; i < kClassKeyCount; i++) {
+        if (kClassTable.slots[Slot(kClassKeys[i].key, kClassKeys[i].length)] != (int8_t)i) return false;
+    }
+    return true;
+}
+static_assert(IsPerfect(), "class key hash table has a collision");
+
+}
+
+ActorCategory ClassifyName(const char* name) {
+    // All keys start with "BP_", so only those positions are hashed
+    for (const char* at = strstr(name, "BP_"); at; at = strstr(at + 1, "BP_")) {
+        size_t available = strnlen(at, 64);
+        for (size_t k = 0; k < kClassKeyCount; k++) {
+            size_t length = kClassKeys[k].length;
+            if (length > available) continue;
+
+            int8_t index = kClassTable.slots[Slot(at, length)];
+            if (index >= 0 && kClassKeys[index].length == length && memcmp(at, kClassKeys[index].key, length) == 0)
+                return kClassKeys[index].category;
+        }
+    }
+    return ActorCategory::Unknown;
+}
+
+bool ActorClassifier::Lookup(uintptr_t actor, uintptr_t stamp, ActorCategory& category) {
+    Entry* entry = entries.Find(actor);
+    if (!entry || entry->stamp != stamp) {
+        misses++;
+        return false;
+    }
+
+    entry->lastSeen = frame;
+    category = entry->category;
+    hits++;
+    return true;
+}
+
+void ActorClassifier::Store(uintptr_t actor, uintptr_t stamp, ActorCategory category) {
+    entries.Insert(actor, { stamp, frame, category });
+}
+
+void ActorClassifier::EndFrame() {
+    frame++;
+    if (frame % kEvictAfterFrames != 0) return;
+
+    uint32_t now = frame;
+    entries.EraseIf([now](uintptr_t, const Entry& entry) { return now - entry.lastSeen > kEvictAfterFrames; });
+}
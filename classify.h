@@ -0,0 +1,50 @@
+/*
+* File: classify.h
+* Actor class categories and per-actor classification cache for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "flatmap.h"
+
+enum class ActorCategory : uint8_t {
+    Unknown,
+    Survivor,
+    Animal,
+};
+
+// Looks for any known class key ("BP_Survivor", "BP_Animal", ...) inside an
+// actor name, the same test the old strstr pair did, via a perfect-hash table.
+ActorCategory ClassifyName(const char* name);
+
+// Remembers each actor's category so names are read once per actor rather than
+// every frame. The stamp (the actor's name pointer) changes when the address is
+// reused by a different object, which forces a reclassification.
+class ActorClassifier {
+public:
+    // True when actor was classified before with the same stamp.
+    bool Lookup(uintptr_t actor, uintptr_t stamp, ActorCategory& category);
+    void Store(uintptr_t actor, uintptr_t stamp, ActorCategory category);
+
+    // Drops actors that have not been looked up for a while.
+    void EndFrame();
+
+    size_t Size() const { return entries.Size(); }
+    uint64_t Hits() const { return hits; }
+    uint64_t Misses() const { return misses; }
+
+private:
+    static constexpr uint32_t kEvictAfterFrames = 300;
+
+    struct Entry {
+        uintptr_t stamp;
+        uint32_t lastSeen;
+        ActorCategory category;
+    };
+
+    FlatAddressMap<Entry> entries;
+    uint32_t frame = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
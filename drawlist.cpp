@@ -0,0 +1,68 @@
+/*
+* File: drawlist.cpp
+* Backend-independent primitive batcher for Winter Survival ESP overlay
+*/
+
+#include "drawlist.h"
+#include <cmath>
+
+void DrawList::Begin(float width, float height) {
+    count = 0;
+    viewportWidth = width > 0.0f ? width : 1.0f;
+    viewportHeight = height > 0.0f ? height : 1.0f;
+    scaleX = 2.0f / viewportWidth;
+    scaleY = 2.0f / viewportHeight;
+}
+
+void DrawList::AddTriangle(const Vec2& a, const Vec2& b, const Vec2& c, const Vec4& color) {
+    // Pixels (y down) to clip space (y up)
+    DrawVertex* out = Allocate(3);
+    out[0] = { a.x * scaleX - 1.0f, 1.0f - a.y * scaleY, 0.0f, color.x, color.y, color.z, color.w };
+    out[1] = { b.x * scaleX - 1.0f, 1.0f - b.y * scaleY, 0.0f, color.x, color.y, color.z, color.w };
+    out[2] = { c.x * scaleX - 1.0f, 1.0f - c.y * scaleY, 0.0f, color.x, color.y, color.z, color.w };
+}
+
+void DrawList::AddQuad(float left, float top, float right, float bottom, const Vec4& color) {
+    float x0 = left * scaleX - 1.0f;
+    float x1 = right * scaleX - 1.0f;
+    float y0 = 1.0f - top * scaleY;
+    float y1 = 1.0f - bottom * scaleY;
+
+    // Hot path for boxes: both triangles written in place
+    DrawVertex* out = Allocate(6);
+    out[0] = { x0, y0, 0.0f, color.x, color.y, color.z, color.w };
+    out[1] = { x1, y0, 0.0f, color.x, color.y, color.z, color.w };
+    out[2] = { x0, y1, 0.0f, color.x, color.y, color.z, color.w };
+    out[3] = out[2];
+    out[4] = out[1];
+    out[5] = { x1, y1, 0.0f, color.x, color.y, color.z, color.w };
+}
+
+void DrawList::AddLine(const Vec2& from, const Vec2& to, float thickness, const Vec4& color) {
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    // Offset both ends by half the thickness along the normal
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    Vec2 a = { from.x + nx, from.y + ny };
+    Vec2 b = { to.x + nx, to.y + ny };
+    Vec2 c = { from.x - nx, from.y - ny };
+    Vec2 d = { to.x - nx, to.y - ny };
+    AddTriangle(a, b, c, color);
+    AddTriangle(c, b, d, color);
+}
+
+void DrawList::AddBox(const Vec2& topLeft, float width, float height, float thickness, const Vec4& color) {
+    float left = topLeft.x;
+    float top = topLeft.y;
+    float right = left + width;
+    float bottom = top + height;
+
+    AddQuad(left, top, right, top + thickness, color);
+    AddQuad(right - thickness, top + thickness, right, bottom - thickness, color);
+    AddQuad(left, bottom - thickness, right, bottom, color);
+    AddQuad(left, top + thickness, left + thickness, bottom - thickness, color);
+}
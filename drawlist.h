@@ -0,0 +1,53 @@
+/*
+* File: drawlist.h
+* Backend-independent primitive batcher for Winter Survival ESP overlay
+*/
+
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "types.h"
+
+// Matches the overlay's input layout: POSITION float3 at 0, COLOR float4 at 12.
+struct DrawVertex {
+    float x, y, z;
+    float r, g, b, a;
+};
+
+// Collects a frame's geometry as one triangle list in clip space, so the
+// renderer can upload it once and draw it with a single call.
+class DrawList {
+public:
+    // Starts a new frame; pixel coordinates are converted with this viewport size.
+    void Begin(float viewportWidth, float viewportHeight);
+
+    // Filled axis-aligned rectangle in pixels.
+    void AddQuad(float left, float top, float right, float bottom, const Vec4& color);
+    // Segment of the given pixel thickness.
+    void AddLine(const Vec2& from, const Vec2& to, float thickness, const Vec4& color);
+    // Outline whose edges lie inside the width x height rectangle at topLeft.
+    void AddBox(const Vec2& topLeft, float width, float height, float thickness, const Vec4& color);
+
+    const DrawVertex* Data() const { return vertices.data(); }
+    size_t VertexCount() const { return count; }
+    float ViewportWidth() const { return viewportWidth; }
+    float ViewportHeight() const { return viewportHeight; }
+
+private:
+    // Storage only ever grows; count is what this frame has used
+    std::vector<DrawVertex> vertices;
+    size_t count = 0;
+    float viewportWidth = 1.0f;
+    float viewportHeight = 1.0f;
+    float scaleX = 2.0f;
+    float scaleY = 2.0f;
+
+    DrawVertex* Allocate(size_t vertexCount) {
+        if (count + vertexCount > vertices.size()) vertices.resize((count + vertexCount) * 2);
+        DrawVertex* out = &vertices[count];
+        count += vertexCount;
+        return out;
+    }
+
+    void AddTriangle(const Vec2& a, const Vec2& b, const Vec2& c, const Vec4& color);
+};
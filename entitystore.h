@@ -0,0 +1,50 @@
+/*
+* File: entitystore.h
+* Structure-of-arrays entity storage for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "classify.h"
+#include "types.h"
+
+enum EntityFlags : uint8_t {
+    kEntityValid = 1 << 0,
+    kEntityRefreshed = 1 << 1,  // position was re-read for this sample
+};
+
+// One sample's entities as parallel columns, so projection and culling stream
+// only the arrays they use (positions go to ProjectPoints as they are). The
+// store is filled in place every frame; Resize keeps capacity, so once it has
+// held the level's peak count it no longer allocates.
+struct EntityStore {
+    std::vector<uint32_t> ids;           // nonzero, stable for as long as the actor stays in the level
+    std::vector<float> x, y, z;          // feet position
+    std::vector<Vec3> extents;           // width, depth, height
+    std::vector<ActorCategory> categories;
+    std::vector<uint8_t> flags;          // EntityFlags
+    std::vector<uint64_t> sampleTimes;   // steady clock ns the position was read at
+
+    size_t Size() const { return ids.size(); }
+
+    void Resize(size_t count) {
+        ids.resize(count);
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        extents.resize(count);
+        categories.resize(count);
+        flags.resize(count);
+        sampleTimes.resize(count);
+    }
+
+    Vec3 Position(size_t i) const { return Vec3{ x[i], y[i], z[i] }; }
+
+    void SetPosition(size_t i, const Vec3& position) {
+        x[i] = position.x;
+        y[i] = position.y;
+        z[i] = position.z;
+    }
+};
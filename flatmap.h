@@ -0,0 +1,109 @@
+/*
+* File: flatmap.h
+* Open-addressed map keyed by remote addresses for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Linear-probing hash map from a nonzero address to a small value, stored in
+// one flat array. Unlike std::unordered_map it allocates only when it grows
+// past its peak size, so a level whose actors churn at a steady count costs no
+// heap traffic. Erase shifts the following run back instead of leaving
+// tombstones, so probe lengths do not decay under churn.
+template<typename Value>
+class FlatAddressMap {
+public:
+    size_t Size() const { return count; }
+
+    Value* Find(uintptr_t key) {
+        if (!count) return nullptr;
+        for (size_t slot = Home(key);; slot = (slot + 1) & mask) {
+            if (slots[slot].key == key) return &slots[slot].value;
+            if (!slots[slot].key) return nullptr;
+        }
+    }
+
+    const Value* Find(uintptr_t key) const {
+        return const_cast<FlatAddressMap*>(this)->Find(key);
+    }
+
+    // Inserts or overwrites.
+    Value& Insert(uintptr_t key, const Value& value) {
+        if ((count + 1) * 2 > slots.size()) Grow();
+        size_t slot = Home(key);
+        while (slots[slot].key && slots[slot].key != key) slot = (slot + 1) & mask;
+        if (!slots[slot].key) count++;
+        slots[slot] = { key, value };
+        return slots[slot].value;
+    }
+
+    bool Erase(uintptr_t key) {
+        if (!count) return false;
+        size_t slot = Home(key);
+        while (slots[slot].key != key) {
+            if (!slots[slot].key) return false;
+            slot = (slot + 1) & mask;
+        }
+        EraseSlot(slot);
+        return true;
+    }
+
+    // Erases every entry pred(key, value) holds for.
+    template<typename Pred>
+    void EraseIf(Pred pred) {
+        for (size_t slot = 0; slot < slots.size();) {
+            // A shifted-in entry lands in this slot, so it is checked again
+            if (slots[slot].key && pred(slots[slot].key, slots[slot].value)) EraseSlot(slot);
+            else slot++;
+        }
+    }
+
+    // Keeps the table's storage.
+    void Clear() {
+        for (Slot& slot : slots) slot.key = 0;
+        count = 0;
+    }
+
+private:
+    struct Slot {
+        uintptr_t key;  // 0 when free
+        Value value;
+    };
+
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+
+    size_t Home(uintptr_t key) const {
+        // Fibonacci hashing; actor addresses share their low bits
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+    }
+
+    void Grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.empty() ? 64 : old.size() * 2, Slot{ 0, Value{} });
+        mask = slots.size() - 1;
+        count = 0;
+        for (const Slot& slot : old) {
+            if (slot.key) Insert(slot.key, slot.value);
+        }
+    }
+
+    void EraseSlot(size_t hole) {
+        // Backward shift: move later members of the run into the hole when
+        // their home slot does not lie strictly between the hole and them
+        for (size_t next = (hole + 1) & mask; slots[next].key; next = (next + 1) & mask) {
+            size_t home = Home(slots[next].key);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = slots[next];
+                hole = next;
+            }
+        }
+        slots[hole].key = 0;
+        count--;
+    }
+};
@@ -0,0 +1,127 @@
+/*
+* File: framepacer.cpp
+* High-resolution frame pacing for Winter Survival ESP
+*/
+
+#include "framepacer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#ifdef _WIN32
+#include <Windows.h>
+#include <immintrin.h>
+#else
+#include <cerrno>
+#include <ctime>
+#include <immintrin.h>
+#endif
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+FramePacer::FramePacer() {
+#ifdef _WIN32
+    // High-resolution timers exist from Windows 10 1803; fall back to a regular one
+    timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timer) timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif
+    errors.reserve(kHistory);
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    if (timer) CloseHandle(timer);
+#endif
+}
+
+uint64_t FramePacer::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void FramePacer::Configure(double rate, Mode newMode) {
+    mode = newMode;
+    period = (uint64_t)(1e9 / (rate > 0.0 ? rate : 60.0));
+    deadline = 0;
+    lastReturn = 0;
+    workEstimate = 0;
+    ResetStats();
+}
+
+void FramePacer::SleepUntil(uint64_t target) {
+    uint64_t now = Now();
+    if (target <= now) return;
+
+#ifdef _WIN32
+    // Relative due time in 100 ns units; negative means relative
+    LARGE_INTEGER due;
+    due.QuadPart = -(LONGLONG)((target - now) / 100);
+    if (timer && SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE)) {
+        WaitForSingleObject(timer, INFINITE);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::nanoseconds(target - now));
+#else
+    // The steady clock is CLOCK_MONOTONIC on Linux, so its value can be used as an absolute deadline
+    timespec when;
+    when.tv_sec = (time_t)(target / 1000000000ull);
+    when.tv_nsec = (long)(target % 1000000000ull);
+    // Retry only interruptions; on any other error the caller's spin covers the rest
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &when, nullptr) == EINTR) {
+    }
+#endif
+}
+
+void FramePacer::Wait() {
+    uint64_t now = Now();
+
+    // Track how long the caller's work takes between our returns
+    if (lastReturn) {
+        uint64_t work = now - lastReturn;
+        workEstimate = workEstimate ? (workEstimate * 7 + work) / 8 : work;
+    }
+
+    if (!deadline) deadline = now + period;
+    // After a stall, drop the missed frames instead of racing to catch up
+    if (now > deadline + period) deadline = now + period - (now - deadline) % period;
+
+    uint64_t target = deadline;
+    if (mode == Mode::LatestPossible) {
+        // Leave time for one frame of work (plus slack) before the boundary
+        uint64_t reserve = workEstimate + workEstimate / 4 + kMinWakeOffset;
+        target = reserve < period ? deadline - reserve : deadline - period + 1;
+        if (target < now) target = now;
+    }
+
+    // Coarse sleep to just before the target, then spin off the remainder
+    if (target > now + wakeOffset) {
+        uint64_t wakeAt = target - wakeOffset;
+        SleepUntil(wakeAt);
+
+        // Adapt: aim to wake about twice the observed oversleep early
+        uint64_t woke = Now();
+        uint64_t oversleep = woke > wakeAt ? woke - wakeAt : 0;
+        uint64_t wanted = (std::min)((std::max)(oversleep * 2, kMinWakeOffset), kMaxWakeOffset);
+        wakeOffset = (wakeOffset * 15 + wanted) / 16;
+    }
+    while (Now() < target) _mm_pause();
+
+    uint64_t returned = Now();
+    int64_t error = (int64_t)(returned - target);
+    if (errors.size() < kHistory) errors.push_back(error);
+    else errors[nextError] = error;
+    nextError = (nextError + 1) % kHistory;
+
+    lastReturn = returned;
+    deadline += period;
+}
+
+int64_t FramePacer::ErrorPercentile(double percentile) const {
+    if (errors.empty()) return 0;
+
+    std::vector<int64_t> sorted(errors);
+    size_t index = (size_t)(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
@@ -0,0 +1,60 @@
+/*
+* File: framepacer.h
+* High-resolution frame pacing for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Paces a loop against absolute deadlines: sleeps with the OS's high-resolution
+// absolute timer until shortly before the deadline, then spins the rest. The
+// wake-up offset adapts to how late the OS actually wakes us.
+class FramePacer {
+public:
+    enum class Mode {
+        // Return at each frame boundary (every 1/rate seconds).
+        TargetRate,
+        // Return as late as possible so the frame's work, at its measured
+        // duration, ends right at the boundary; keeps sampled data freshest.
+        LatestPossible,
+    };
+
+    FramePacer();
+    ~FramePacer();
+
+    void Configure(double rate, Mode mode);
+
+    // Blocks until the next frame should start.
+    void Wait();
+
+    static uint64_t Now();  // steady clock, nanoseconds
+
+    // Lateness of each wake-up against its target, over the last kHistory frames.
+    int64_t ErrorPercentile(double percentile) const;
+    uint64_t WakeOffset() const { return wakeOffset; }
+    uint64_t WorkEstimate() const { return workEstimate; }
+    void ResetStats() { errors.clear(); nextError = 0; }
+
+private:
+    static constexpr size_t kHistory = 4096;
+    static constexpr uint64_t kMinWakeOffset = 200000;     // 0.2 ms
+    static constexpr uint64_t kMaxWakeOffset = 4000000;    // 4 ms
+
+    Mode mode = Mode::TargetRate;
+    uint64_t period = 16666667;
+    uint64_t deadline = 0;     // next frame boundary
+    uint64_t lastReturn = 0;   // when Wait last returned, to measure the work in between
+    uint64_t wakeOffset = 1000000;
+    uint64_t workEstimate = 0;
+
+    std::vector<int64_t> errors;
+    size_t nextError = 0;
+
+#ifdef _WIN32
+    void* timer = nullptr;
+#endif
+
+    void SleepUntil(uint64_t target);
+};
@@ -0,0 +1,287 @@
+/*
+* File: livebackend.cpp
+* Live process memory backend for Winter Survival ESP
+*/
+
+#include "livebackend.h"
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#include <TlHelp32.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#endif
+
+LiveBackend::LiveBackend(ProcessHandle process, uint32_t processId)
+    : process(process), processId(processId) {
+}
+
+#ifdef _WIN32
+
+LiveBackend::~LiveBackend() {
+    if (process) CloseHandle(process);
+}
+
+bool LiveBackend::Read(uintptr_t address, void* buffer, size_t size) {
+    readCalls++;
+    readBytes += size;
+    if (ReadProcessMemory(process, (LPCVOID)address, buffer, size, nullptr)) return true;
+    memset(buffer, 0, size);
+    return false;
+}
+
+size_t LiveBackend::ReadBatch(ReadRequest* requests, size_t count) {
+    order.resize(count);
+    for (uint32_t i = 0; i < count; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [requests](uint32_t a, uint32_t b) {
+        return requests[a].address < requests[b].address;
+    });
+
+    size_t succeeded = 0;
+    size_t first = 0;
+    while (first < count) {
+        // Grow the span while the next request starts close to its end
+        uintptr_t spanStart = requests[order[first]].address;
+        uintptr_t spanEnd = spanStart + requests[order[first]].size;
+        size_t last = first + 1;
+        while (last < count) {
+            const ReadRequest& next = requests[order[last]];
+            uintptr_t nextEnd = (std::max)(spanEnd, next.address + next.size);
+            if (next.address > spanEnd + kCoalesceGap || nextEnd - spanStart > kMaxSpan) break;
+            spanEnd = nextEnd;
+            last++;
+        }
+
+        if (last - first > 1) {
+            spanBuffer.resize(spanEnd - spanStart);
+            readCalls++;
+            readBytes += spanBuffer.size();
+            if (ReadProcessMemory(process, (LPCVOID)spanStart, spanBuffer.data(), spanBuffer.size(), nullptr)) {
+                for (size_t i = first; i < last; i++) {
+                    ReadRequest& request = requests[order[i]];
+                    memcpy(request.buffer, spanBuffer.data() + (request.address - spanStart), request.size);
+                    request.ok = true;
+                    succeeded++;
+                }
+                first = last;
+                continue;
+            }
+        }
+
+        // Lone request, or part of the span is unmapped: read the members one by one
+        for (size_t i = first; i < last; i++) {
+            ReadRequest& request = requests[order[i]];
+            request.ok = Read(request.address, request.buffer, request.size);
+            succeeded += request.ok;
+        }
+        first = last;
+    }
+
+    return succeeded;
+}
+
+bool LiveBackend::Query(uintptr_t address, MemoryRegion& region) {
+    MEMORY_BASIC_INFORMATION mbi;
+    if (!VirtualQueryEx(process, (LPCVOID)address, &mbi, sizeof(mbi))) return false;
+
+    region.base = (uintptr_t)mbi.BaseAddress;
+    region.size = mbi.RegionSize;
+    region.committed = mbi.State == MEM_COMMIT;
+    region.protect = 0;
+    if (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) return true;
+
+    if (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+        PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY))
+        region.protect |= kProtectRead;
+    if (mbi.Protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY))
+        region.protect |= kProtectWrite;
+    if (mbi.Protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY))
+        region.protect |= kProtectExecute;
+    return true;
+}
+
+uintptr_t LiveBackend::ModuleBase(const char* moduleName) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, processId);
+    if (snapshot == INVALID_HANDLE_VALUE) return 0;
+
+    wchar_t wideName[MAX_MODULE_NAME32 + 1] = { 0 };
+    for (size_t i = 0; moduleName[i] && i < MAX_MODULE_NAME32; i++) wideName[i] = (wchar_t)moduleName[i];
+
+    MODULEENTRY32W moduleEntry;
+    moduleEntry.dwSize = sizeof(moduleEntry);
+
+    if (Module32FirstW(snapshot, &moduleEntry)) {
+        do {
+            if (_wcsicmp(moduleEntry.szModule, wideName) == 0) {
+                CloseHandle(snapshot);
+                return (uintptr_t)moduleEntry.modBaseAddr;
+            }
+        } while (Module32NextW(snapshot, &moduleEntry));
+    }
+
+    CloseHandle(snapshot);
+    return 0;
+}
+
+#else
+
+LiveBackend::~LiveBackend() {
+}
+
+bool LiveBackend::Read(uintptr_t address, void* buffer, size_t size) {
+    iovec local = { buffer, size };
+    iovec remote = { (void*)address, size };
+    readCalls++;
+    readBytes += size;
+    if (process_vm_readv(process, &local, 1, &remote, 1, 0) == (ssize_t)size) return true;
+    memset(buffer, 0, size);
+    return false;
+}
+
+size_t LiveBackend::ReadBatch(ReadRequest* requests, size_t count) {
+    static const size_t maxIov = (std::max)(sysconf(_SC_IOV_MAX), 1L);
+
+    localIov.resize(count);
+    remoteIov.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        localIov[i] = { requests[i].buffer, requests[i].size };
+        remoteIov[i] = { (void*)requests[i].address, requests[i].size };
+        requests[i].ok = false;
+    }
+
+    size_t succeeded = 0;
+    size_t first = 0;
+    while (first < count) {
+        size_t batch = (std::min)(count - first, maxIov);
+        readCalls++;
+        ssize_t result = process_vm_readv(process, &localIov[first], batch, &remoteIov[first], batch, 0);
+        size_t bytes = result > 0 ? (size_t)result : 0;
+        readBytes += bytes;
+
+        // process_vm_readv stops at the first remote iovec it cannot read, so everything
+        // before it completed and the request it stopped in has failed
+        size_t i = first;
+        for (; i < first + batch && bytes >= requests[i].size; i++) {
+            bytes -= requests[i].size;
+            requests[i].ok = true;
+            succeeded++;
+        }
+        if (i < first + batch) {
+            memset(requests[i].buffer, 0, requests[i].size);
+            i++;
+        }
+        first = i;
+    }
+
+    return succeeded;
+}
+
+bool LiveBackend::ReadMaps() {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/maps", (int)process);
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    // "start-end perms offset dev inode   pathname"
+    maps.clear();
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long long start, end;
+        char perms[5];
+        int consumed = 0;
+        if (sscanf(line, "%llx-%llx %4s %*s %*s %*s %n", &start, &end, perms, &consumed) < 3) continue;
+
+        MappedRegion mapped;
+        mapped.region.base = (uintptr_t)start;
+        mapped.region.size = (size_t)(end - start);
+        mapped.region.committed = true;
+        mapped.region.protect = (perms[0] == 'r' ? (uint32_t)kProtectRead : 0) |
+            (perms[1] == 'w' ? (uint32_t)kProtectWrite : 0) | (perms[2] == 'x' ? (uint32_t)kProtectExecute : 0);
+        if (consumed) {
+            mapped.path = line + consumed;
+            while (!mapped.path.empty() && (mapped.path.back() == '\n' || mapped.path.back() == ' '))
+                mapped.path.pop_back();
+        }
+        maps.push_back(std::move(mapped));
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool LiveBackend::Query(uintptr_t address, MemoryRegion& region) {
+    if (maps.empty() || address <= lastQuery) {
+        if (!ReadMaps()) return false;
+    }
+    lastQuery = address;
+
+    // maps is sorted by address; gaps are skipped like free regions are on Windows
+    auto it = std::upper_bound(maps.begin(), maps.end(), address, [](uintptr_t value, const MappedRegion& mapped) {
+        return value < mapped.region.base + mapped.region.size;
+    });
+    if (it == maps.end()) return false;
+
+    region = it->region;
+    return true;
+}
+
+uintptr_t LiveBackend::ModuleBase(const char* moduleName) {
+    if (!ReadMaps()) return 0;
+
+    // A module is every mapping of one file; its base is the lowest of them
+    for (const MappedRegion& mapped : maps) {
+        size_t slash = mapped.path.find_last_of('/');
+        const char* fileName = mapped.path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+        if (strcmp(fileName, moduleName) == 0) return mapped.region.base;
+    }
+    return 0;
+}
+
+pid_t LiveBackend::FindProcess(const char* name) {
+    DIR* proc = opendir("/proc");
+    if (!proc) return 0;
+
+    pid_t found = 0;
+    while (dirent* entry = readdir(proc)) {
+        char* end;
+        long pid = strtol(entry->d_name, &end, 10);
+        if (*end || pid <= 0) continue;
+
+        char path[64], buffer[512];
+        snprintf(path, sizeof(path), "/proc/%ld/comm", pid);
+        if (FILE* file = fopen(path, "r")) {
+            size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+            fclose(file);
+            while (length && buffer[length - 1] == '\n') length--;
+            buffer[length] = 0;
+            if (length && strncmp(buffer, name, length) == 0 && (name[length] == 0 || length == 15)) {
+                found = (pid_t)pid;
+                break;
+            }
+        }
+
+        // argv[0] may be a Windows path under Wine
+        snprintf(path, sizeof(path), "/proc/%ld/cmdline", pid);
+        if (FILE* file = fopen(path, "r")) {
+            size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+            fclose(file);
+            buffer[length] = 0;
+            const char* fileName = buffer;
+            for (const char* c = buffer; *c; c++) {
+                if (*c == '/' || *c == '\\') fileName = c + 1;
+            }
+            if (length && strcmp(fileName, name) == 0) {
+                found = (pid_t)pid;
+                break;
+            }
+        }
+    }
+
+    closedir(proc);
+    return found;
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+* File: livebackend.h
+* Live process memory backend for Winter Survival ESP
+*/
+
+#pragma once
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+#include "backend.h"
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+using ProcessHandle = HANDLE;
+#else
+using ProcessHandle = pid_t;
+#endif
+
+// Reads another process: ReadProcessMemory on Windows, process_vm_readv on Linux.
+class LiveBackend : public MemoryBackend {
+public:
+    // Takes ownership of the handle on Windows.
+    LiveBackend(ProcessHandle process, uint32_t processId);
+    ~LiveBackend() override;
+
+    bool Read(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(ReadRequest* requests, size_t count) override;
+    bool Query(uintptr_t address, MemoryRegion& region) override;
+    uintptr_t ModuleBase(const char* moduleName) override;
+
+#ifndef _WIN32
+    // First process whose comm (15 chars, as the kernel truncates it) or
+    // argv[0] file name matches, 0 if there is none.
+    static pid_t FindProcess(const char* name);
+#endif
+
+private:
+    ProcessHandle process;
+    uint32_t processId;
+
+#ifdef _WIN32
+    // Windows has no vectored cross-process read, so requests closer than
+    // kCoalesceGap are merged into one span read instead.
+    static constexpr size_t kCoalesceGap = 256;
+    static constexpr size_t kMaxSpan = 64 * 1024;
+
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> spanBuffer;
+#else
+    std::vector<iovec> localIov;
+    std::vector<iovec> remoteIov;
+
+    // /proc/<pid>/maps as of the current region walk; a walk that moves
+    // backwards re-reads it
+    struct MappedRegion {
+        MemoryRegion region;
+        std::string path;
+    };
+    std::vector<MappedRegion> maps;
+    uintptr_t lastQuery = 0;
+
+    bool ReadMaps();
+#endif
+};
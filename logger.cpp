@@ -0,0 +1,201 @@
+/*
+* File: logger.cpp
+* Asynchronous logging for Winter Survival ESP
+*/
+
+#include "logger.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+
+constexpr size_t kSlots = 4096;  // power of two
+constexpr size_t kTextSize = 240;
+
+// Bounded queue after Vyukov: a slot's sequence says whose turn it is, so
+// producers only contend on one compare-exchange of the head
+struct Slot {
+    std::atomic<size_t> sequence;
+    uint64_t time;
+    uint32_t thread;
+    LogLevel level;
+    char text[kTextSize];
+};
+
+std::unique_ptr<Slot[]> slots;
+std::atomic<size_t> head{ 0 };
+size_t tail = 0;
+
+std::atomic<bool> running{ false };
+// Writes between checking running and publishing their slot; Stop waits for
+// them so a claimed slot is never left behind by the final drain
+std::atomic<uint32_t> writers{ 0 };
+std::thread flusher;
+FILE* file = nullptr;
+
+std::atomic<uint32_t> nextThread{ 0 };
+
+uint32_t ThreadIndex() {
+    thread_local uint32_t index = ++nextThread;
+    return index;
+}
+
+uint64_t NowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t NowUs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* LevelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Trace: return "TRACE";
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info: return "INFO ";
+    case LogLevel::Warning: return "WARN ";
+    case LogLevel::Error: return "ERROR";
+    default: return "?    ";
+    }
+}
+
+uint64_t startTime = 0;
+uint64_t reportedDrops = 0;
+
+// Consumer side; only the flusher thread (or Stop, after joining it) calls this
+size_t Drain(FILE* out) {
+    size_t written = 0;
+    while (true) {
+        Slot& slot = slots[tail & (kSlots - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+        uint64_t elapsed = slot.time - startTime;
+        fprintf(out, "[%6llu.%06llu] %s (t%u) %s\n",
+            (unsigned long long)(elapsed / 1000000), (unsigned long long)(elapsed % 1000000),
+            LevelName(slot.level), slot.thread, slot.text);
+
+        slot.sequence.store(tail + kSlots, std::memory_order_release);
+        tail++;
+        written++;
+    }
+
+    uint64_t drops = Logger::Dropped();
+    if (drops != reportedDrops) {
+        fprintf(out, "[logger] %llu messages dropped, ring was full\n", (unsigned long long)(drops - reportedDrops));
+        reportedDrops = drops;
+        written++;
+    }
+    return written;
+}
+
+void Flush() {
+    while (running.load(std::memory_order_acquire)) {
+        if (Drain(file)) fflush(file);
+        else std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+}
+
+std::atomic<uint64_t> Logger::dropped{ 0 };
+
+bool Logger::Start(const char* path) {
+    if (running) return true;
+
+    file = fopen(path, "w");
+    if (!file) return false;
+
+    if (!slots) slots.reset(new Slot[kSlots]);
+    for (size_t i = 0; i < kSlots; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    head.store(0, std::memory_order_relaxed);
+    tail = 0;
+    startTime = NowUs();
+
+    running.store(true, std::memory_order_release);
+    flusher = std::thread(Flush);
+    return true;
+}
+
+void Logger::Stop() {
+    if (!running) return;
+
+    // Sequentially consistent against Write's increment-then-check: a writer
+    // either sees running cleared or is counted here
+    running.store(false);
+    flusher.join();
+    while (writers.load()) std::this_thread::yield();
+    Drain(file);
+    fclose(file);
+    file = nullptr;
+}
+
+void Logger::Write(LogLevel level, uint32_t suppressed, const char* format, ...) {
+    char* text;
+    char local[kTextSize];
+    Slot* slot = nullptr;
+    size_t position = 0;
+
+    writers.fetch_add(1);
+    if (running.load()) {
+        position = head.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& candidate = slots[position & (kSlots - 1)];
+            intptr_t turn = (intptr_t)candidate.sequence.load(std::memory_order_acquire) - (intptr_t)position;
+            if (turn == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot = &candidate;
+                    break;
+                }
+            }
+            else if (turn < 0) {
+                // Full: the flusher is behind, drop rather than wait
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                writers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+        text = slot->text;
+    }
+    else {
+        writers.fetch_sub(1, std::memory_order_release);
+        text = local;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, kTextSize, format, args);
+    va_end(args);
+    if (suppressed && length >= 0 && (size_t)length < kTextSize)
+        snprintf(text + length, kTextSize - length, " (%u similar suppressed)", suppressed);
+
+    if (!slot) {
+        fprintf(stderr, "%s %s\n", LevelName(level), text);
+        return;
+    }
+
+    slot->time = NowUs();
+    slot->thread = ThreadIndex();
+    slot->level = level;
+    slot->sequence.store(position + 1, std::memory_order_release);
+    writers.fetch_sub(1, std::memory_order_release);
+}
+
+bool LogRateLimit::Allow(uint64_t intervalMs, uint32_t& suppressed) {
+    uint64_t now = NowMs();
+    uint64_t previous = last.load(std::memory_order_relaxed);
+    if ((previous && now - previous < intervalMs) ||
+        !last.compare_exchange_strong(previous, now, std::memory_order_relaxed)) {
+        skipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressed = skipped.exchange(0, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,74 @@
+/*
+* File: logger.h
+* Asynchronous logging for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+};
+
+// Levels below this are compiled out, arguments included
+#ifndef WSS_LOG_LEVEL
+#ifdef NDEBUG
+#define WSS_LOG_LEVEL 2
+#else
+#define WSS_LOG_LEVEL 1
+#endif
+#endif
+
+// Producers format into a slot of a lock-free ring and return; a background
+// thread writes the ring out to the log file. When the ring is full messages
+// are dropped (and counted) rather than blocking the caller.
+class Logger {
+public:
+    // Without a running logger, messages go straight to stderr.
+    static bool Start(const char* path);
+    // Writes out everything queued so far and closes the file.
+    static void Stop();
+
+    static void Write(LogLevel level, uint32_t suppressed, const char* format, ...);
+
+    static uint64_t Dropped() { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<uint64_t> dropped;
+};
+
+// Lets one message per interval through from a call site and counts the rest.
+class LogRateLimit {
+public:
+    bool Allow(uint64_t intervalMs, uint32_t& suppressed);
+
+private:
+    std::atomic<uint64_t> last{ 0 };
+    std::atomic<uint32_t> skipped{ 0 };
+};
+
+#define WSS_LOG(level, ...) \
+    do { \
+        if constexpr ((int)(level) >= WSS_LOG_LEVEL) Logger::Write(level, 0, __VA_ARGS__); \
+    } while (0)
+
+// For paths that run every frame: at most one message per second from this call site
+#define WSS_LOG_LIMITED(level, ...) \
+    do { \
+        if constexpr ((int)(level) >= WSS_LOG_LEVEL) { \
+            static LogRateLimit limit; \
+            uint32_t suppressed; \
+            if (limit.Allow(1000, suppressed)) Logger::Write(level, suppressed, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_TRACE(...) WSS_LOG(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) WSS_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) WSS_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) WSS_LOG(LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) WSS_LOG(LogLevel::Error, __VA_ARGS__)
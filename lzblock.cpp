@@ -0,0 +1,119 @@
+/*
+* File: lzblock.cpp
+* Fast LZ77 block compression for Winter Survival ESP
+*/
+
+#include "lzblock.h"
+#include <cstring>
+
+static constexpr size_t kMinMatch = 4;
+static constexpr size_t kMaxOffset = 65535;
+// The tail is always left as literals, so the matcher can read 4 bytes anywhere
+static constexpr size_t kTailLiterals = 8;
+static constexpr int kHashBits = 12;
+
+static uint32_t Load32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+static uint8_t* WriteLength(uint8_t* out, size_t length) {
+    for (; length >= 255; length -= 255) *out++ = 255;
+    *out++ = (uint8_t)length;
+    return out;
+}
+
+static uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - kMinMatch : 0;
+    *out++ = (uint8_t)(((literalCount < 15 ? literalCount : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+    if (literalCount >= 15) out = WriteLength(out, literalCount - 15);
+    memcpy(out, literals, literalCount);
+    out += literalCount;
+    if (!matchLength) return out;
+
+    *out++ = (uint8_t)offset;
+    *out++ = (uint8_t)(offset >> 8);
+    if (matchCode >= 15) out = WriteLength(out, matchCode - 15);
+    return out;
+}
+
+size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst) {
+    uint32_t table[1 << kHashBits] = {};  // position + 1 of the last sequence with that hash
+    uint8_t* out = dst;
+    size_t anchor = 0;
+    size_t position = 0;
+    size_t limit = size > kTailLiterals ? size - kTailLiterals : 0;
+
+    while (position < limit) {
+        uint32_t sequence = Load32(src + position);
+        uint32_t& slot = table[Hash(sequence)];
+        size_t candidate = slot;
+        slot = (uint32_t)position + 1;
+
+        if (!candidate || position - (candidate - 1) > kMaxOffset || Load32(src + candidate - 1) != sequence) {
+            position++;
+            continue;
+        }
+
+        size_t match = candidate - 1;
+        size_t length = kMinMatch;
+        while (position + length < limit && src[match + length] == src[position + length]) length++;
+
+        out = WriteSequence(out, src + anchor, position - anchor, position - match, length);
+        position += length;
+        anchor = position;
+    }
+
+    // The final sequence is literals only; the decoder stops at the end of input
+    out = WriteSequence(out, src + anchor, size - anchor, 0, 0);
+    return (size_t)(out - dst);
+}
+
+static bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool LzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) {
+    const uint8_t* in = src;
+    const uint8_t* end = src + size;
+    size_t written = 0;
+
+    while (in < end) {
+        uint8_t token = *in++;
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !ReadLength(in, end, literalCount)) return false;
+        if (literalCount > (size_t)(end - in) || literalCount > rawSize - written) return false;
+        memcpy(dst + written, in, literalCount);
+        in += literalCount;
+        written += literalCount;
+        if (in == end) break;
+
+        if (end - in < 2) return false;
+        size_t offset = in[0] | (size_t)in[1] << 8;
+        in += 2;
+        size_t length = token & 15;
+        if (length == 15 && !ReadLength(in, end, length)) return false;
+        length += kMinMatch;
+        if (!offset || offset > written || length > rawSize - written) return false;
+
+        // Byte by byte: a match may overlap the bytes it is producing
+        const uint8_t* from = dst + written - offset;
+        uint8_t* to = dst + written;
+        if (offset >= length) memcpy(to, from, length);
+        else for (size_t i = 0; i < length; i++) to[i] = from[i];
+        written += length;
+    }
+
+    return written == rawSize;
+}
@@ -0,0 +1,24 @@
+/*
+* File: lzblock.h
+* Fast LZ77 block compression for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Byte-oriented LZ77 in the LZ4 style: a token with literal and match length
+// nibbles, the literals, a 16-bit back offset, and 255-runs for long lengths.
+// Greedy single-probe matching keeps compression at memory-copy speeds; the
+// recorder's delta-encoded frames are mostly runs of zeros and repeats.
+
+// Worst-case compressed size for size input bytes.
+inline size_t LzBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+// Compresses src into dst (at least LzBound(size) bytes) and returns the compressed size.
+size_t LzCompress(const uint8_t* src, size_t size, uint8_t* dst);
+
+// Decompresses exactly rawSize bytes into dst; false if src is malformed.
+bool LzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize);
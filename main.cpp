@@ -3,42 +3,226 @@
 * Main entry point for Winter Survival ESP
 */
 
+#include <Windows.h>
 #include "memory.h"
 #include "overlay.h"
+#include "framepacer.h"
+#include "logger.h"
+#include "motion.h"
+#include "profiler.h"
+#include "readerthread.h"
+#include "recording.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <utility>
+
+// Reads "--name=value" from the command line, or returns fallback
+static double ArgValue(const char* commandLine, const char* name, double fallback) {
+    const char* at = commandLine ? strstr(commandLine, name) : nullptr;
+    if (!at) return fallback;
+    double value = atof(at + strlen(name));
+    return value > 0 ? value : fallback;
+}
+
+// Copies the "--name=value" path argument into out; false if it is absent
+static bool ArgPath(const char* commandLine, const char* name, char* out, size_t size) {
+    const char* at = commandLine ? strstr(commandLine, name) : nullptr;
+    if (!at) return false;
+    at += strlen(name);
+    size_t length = strcspn(at, " \t");
+    if (!length || length >= size) return false;
+    memcpy(out, at, length);
+    out[length] = 0;
+    return true;
+}
+
+// Feeds a recording to the overlay instead of the game. At original speed the
+// frames are released as their timestamps come due and drawn through the
+// predictor like live samples; "--unthrottled" decodes and draws one frame per
+// iteration as fast as possible, for measuring render throughput.
+static int Replay(const char* path, const char* commandLine) {
+    SnapshotPlayer player;
+    if (!player.Open(path)) {
+        LOG_ERROR("Failed to open recording %s", path);
+        return 1;
+    }
+
+    Overlay overlay;
+    if (!overlay.Initialize(false)) {
+        LOG_ERROR("Failed to initialize overlay");
+        return 1;
+    }
+
+    // Vsync paces replay unless "--render-hz=" sets a rate; unthrottled runs flat out
+    bool unthrottled = strstr(commandLine, "--unthrottled") != nullptr;
+    bool paced = !unthrottled && strstr(commandLine, "--render-hz=") != nullptr;
+    overlay.SetVsync(!unthrottled && !paced);
+    FramePacer pacer;
+    pacer.Configure(ArgValue(commandLine, "--render-hz=", 60.0), FramePacer::Mode::TargetRate);
+
+    MotionPredictor predictor;
+    MotionPredictor::Settings motion;
+    if (strstr(commandLine, "--motion=interpolate")) motion.mode = MotionPredictor::Mode::Interpolate;
+    predictor.Configure(motion);
+
+    // current is on screen, upcoming is the next frame to come due
+    WorldSnapshot current, upcoming;
+    if (!player.Next(current)) {
+        LOG_ERROR("Recording %s holds no frames", path);
+        return 1;
+    }
+    bool more = player.Next(upcoming);
+    uint64_t offset = FramePacer::Now() - current.timestamp;  // recording clock to steady clock
+
+    LOG_INFO("Replaying %s... Press END to exit", path);
+
+    uint64_t frames = 0;
+    uint64_t start = FramePacer::Now();
+    while (!(GetAsyncKeyState(VK_END) & 1)) {
+        if (unthrottled) {
+            // Loop the file so the measurement runs as long as wanted
+            if (!player.Next(current)) {
+                player.Rewind();
+                if (!player.Next(current)) break;
+            }
+            overlay.BeginScene();
+            overlay.Render(current);
+            overlay.EndScene();
+        } else {
+            if (paced) pacer.Wait();
+            uint64_t now = FramePacer::Now() - offset;
+            while (more && upcoming.timestamp <= now) {
+                std::swap(current, upcoming);
+                more = player.Next(upcoming);
+            }
+            overlay.BeginScene();
+            overlay.Render(predictor.Predict(current, now));
+            overlay.EndScene();
+        }
+        frames++;
+    }
+
+    double seconds = (FramePacer::Now() - start) / 1e9;
+    LOG_INFO("Replayed %llu frames in %.1f s (%.1f frames/s)", (unsigned long long)frames, seconds,
+        seconds > 0 ? frames / seconds : 0.0);
+    return 0;
+}
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    MessageBoxA(NULL, "Starting...", "Debug", MB_OK);
+    Logger::Start("wss.log");
+    LOG_INFO("Starting...");
+
+    // "--profile" records from the start (covers the signature scan); F10 toggles it
+    if (strstr(lpCmdLine, "--profile")) Profiler::SetEnabled(true);
+
+    // "--replay=file" draws a recording instead of reading the game
+    char path[260];
+    if (ArgPath(lpCmdLine, "--replay=", path, sizeof(path))) {
+        int result = Replay(path, lpCmdLine);
+        Logger::Stop();
+        return result;
+    }
 
     MemoryReader memory;
     if (!memory.Initialize()) {
-        MessageBoxA(NULL, "Failed to initialize memory reader", "Debug", MB_OK);
+        LOG_ERROR("Failed to initialize memory reader");
+        Logger::Stop();
         return 1;
     }
 
-    MessageBoxA(NULL, "Memory reader initialized", "Debug", MB_OK);
+    LOG_INFO("Memory reader initialized");
+
+    // Remote line cache geometry, for tuning against the hit/miss counts logged at exit
+    memory.Cache().Configure((size_t)ArgValue(lpCmdLine, "--cache-line=", PageCache::kDefaultLineSize),
+        (size_t)ArgValue(lpCmdLine, "--cache-lines=", PageCache::kDefaultLineCount));
 
     Overlay overlay;
     if (!overlay.Initialize()) {
-        MessageBoxA(NULL, "Failed to initialize overlay", "Debug", MB_OK);
+        LOG_ERROR("Failed to initialize overlay");
+        Logger::Stop();
         return 1;
     }
 
-    MessageBoxA(NULL, "Overlay initialized", "Debug", MB_OK);
-    MessageBoxA(NULL, "Running... Press END to exit", "Debug", MB_OK);
+    LOG_INFO("Overlay initialized");
+
+    // Memory is sampled on its own thread; the render loop picks up the newest sample and
+    // moves every entity to the present, so sampling can run well below the display rate
+    double readRate = ArgValue(lpCmdLine, "--read-hz=", 30.0);
+    double renderRate = ArgValue(lpCmdLine, "--render-hz=", 60.0);
+
+    // "--record=file" streams every sample to disk for replay
+    SnapshotRecorder recorder;
+    ReaderThread reader;
+    if (ArgPath(lpCmdLine, "--record=", path, sizeof(path))) {
+        if (recorder.Start(path)) reader.SetRecorder(&recorder);
+        else LOG_WARNING("Failed to open recording %s", path);
+    }
+    reader.Start(memory, readRate);
+
+    // Without "--render-hz=" or "--pace=late" frames are tear-free, paced by vsync.
+    // With them, FramePacer sets the rate ("late" renders as late as possible
+    // before each frame boundary) and Present stops waiting for vblank
+    bool lateLatch = strstr(lpCmdLine, "--pace=late") != nullptr;
+    bool paced = lateLatch || strstr(lpCmdLine, "--render-hz=") != nullptr;
+    overlay.SetVsync(!paced);
+    FramePacer pacer;
+    pacer.Configure(renderRate, lateLatch ? FramePacer::Mode::LatestPossible : FramePacer::Mode::TargetRate);
+
+    // "--motion=interpolate" draws one sample interval behind instead of extrapolating
+    MotionPredictor predictor;
+    MotionPredictor::Settings motion;
+    if (strstr(lpCmdLine, "--motion=interpolate")) motion.mode = MotionPredictor::Mode::Interpolate;
+    predictor.Configure(motion);
+
+    LOG_INFO("Running... Press END to exit");
 
     while (true) {
         if (GetAsyncKeyState(VK_END) & 1) {
-            MessageBoxA(NULL, "Exiting", "Debug", MB_OK);
+            LOG_INFO("Exiting");
             break;
         }
 
+        // Stopping a recording writes it out next to the executable. The reader
+        // thread records too, so it is paused while the profiler resets or exports
+        if (GetAsyncKeyState(VK_F10) & 1) {
+            reader.Stop();
+            bool recording = Profiler::Enabled();
+            Profiler::SetEnabled(!recording);
+            if (recording) {
+                Profiler::WriteTrace("profile.json");
+                Profiler::WriteCsv("profile.csv");
+            }
+            reader.Start(memory, readRate);
+        }
+
+        // Capture the current process state for offline replay; the reader
+        // thread takes it, so sampling pauses but the overlay keeps drawing
+        if (GetAsyncKeyState(VK_F9) & 1) reader.RequestCapture("capture.wss");
+
+        if (paced) pacer.Wait();
+
         overlay.BeginScene();
-        overlay.Render(memory);
+        overlay.Render(predictor.Predict(reader.Latest(), FramePacer::Now()));
         overlay.EndScene();
+    }
+
+    reader.Stop();
+    if (recorder.Recording()) {
+        recorder.Stop();
+        LOG_INFO("Recorded %llu frames (%llu dropped): %llu bytes raw, %llu in file",
+            (unsigned long long)recorder.Frames(), (unsigned long long)recorder.Dropped(),
+            (unsigned long long)recorder.RawBytes(), (unsigned long long)recorder.FileBytes());
+    }
+    LOG_INFO("Line cache: %llu hits, %llu misses", (unsigned long long)memory.Cache().Hits(),
+        (unsigned long long)memory.Cache().Misses());
 
-        Sleep(16); // ~60 FPS
+    if (Profiler::Enabled()) {
+        Profiler::SetEnabled(false);
+        Profiler::WriteTrace("profile.json");
+        Profiler::WriteCsv("profile.csv");
     }
 
+    Logger::Stop();
     return 0;
 }
\ No newline at end of file
@@ -1,165 +1,332 @@
 #include "memory.h"
+#include "livebackend.h"
+#include "logger.h"
+#include "profiler.h"
+#include "scanner.h"
+#include "sigcache.h"
+#include "snapshotbackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
+static uint64_t SampleClock() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 bool MemoryReader::Initialize() {
+#ifdef _WIN32
     HWND window = FindWindowA(NULL, "WSS 64  ");
     if (!window) {
-        MessageBoxA(NULL, "Failed to find WSS 64 window", "Debug", MB_OK);
+        LOG_ERROR("Failed to find WSS 64 window");
         return false;
     }
 
     DWORD processId;
     GetWindowThreadProcessId(window, &processId);
     if (!processId) {
-        MessageBoxA(NULL, "Failed to get process ID", "Debug", MB_OK);
+        LOG_ERROR("Failed to get process ID");
         return false;
     }
 
-    processHandle = OpenProcess(PROCESS_VM_READ | PROCESS_QUERY_INFORMATION, FALSE, processId);
+    HANDLE processHandle = OpenProcess(PROCESS_VM_READ | PROCESS_QUERY_INFORMATION, FALSE, processId);
     if (!processHandle) {
-        MessageBoxA(NULL, "Failed to open process", "Debug", MB_OK);
+        LOG_ERROR("Failed to open process");
+        return false;
+    }
+
+    return Initialize(std::make_unique<LiveBackend>(processHandle, (uint32_t)processId));
+#else
+    // The game runs under Proton/Wine on Linux, so it is found by its executable name
+    pid_t processId = LiveBackend::FindProcess(kModuleName);
+    if (!processId) {
+        LOG_ERROR("Failed to find process %s", kModuleName);
         return false;
     }
 
-    moduleBase = GetModuleBaseAddress(processId, L"WSS-Win64-Shipping.exe");
+    return Initialize(std::make_unique<LiveBackend>(processId, (uint32_t)processId));
+#endif
+}
+
+bool MemoryReader::Initialize(std::unique_ptr<MemoryBackend> source) {
+    auto cached = std::make_unique<PageCache>(std::move(source));
+    cache = cached.get();
+    backend = std::move(cached);
+    viewChain.Invalidate();
+    // Actors of a previous attachment mean nothing in this one
+    tracker.Clear();
+    unresolved.clear();
+    retrying.clear();
+    uLevel = 0;
+    if (!prefetch) prefetch = std::make_unique<WorkStealingPool>(1);
+
+    moduleBase = backend->ModuleBase(kModuleName);
     if (!moduleBase) {
-        MessageBoxA(NULL, "Failed to find game executable", "Debug", MB_OK);
+        LOG_ERROR("Failed to find game executable");
         return false;
     }
 
     if (!FindUWorld()) {
-        MessageBoxA(NULL, "Failed to find UWorld", "Debug", MB_OK);
+        LOG_ERROR("Failed to find UWorld");
         return false;
     }
 
-    char debug[256];
-    sprintf_s(debug, "ModuleBase: 0x%llX\nUWorld: 0x%llX",
-        moduleBase, uWorld);
-    MessageBoxA(NULL, debug, "Debug", MB_OK);
+    LOG_INFO("ModuleBase: 0x%llX, UWorld: 0x%llX",
+        (unsigned long long)moduleBase, (unsigned long long)uWorld);
 
     return true;
 }
 
-bool MemoryReader::FindUWorld() {
-    MEMORY_BASIC_INFORMATION mbi;
-    uintptr_t addr = moduleBase;
-
-    while (VirtualQueryEx(processHandle, (LPVOID)addr, &mbi, sizeof(mbi))) {
-        if (mbi.State == MEM_COMMIT &&
-            (mbi.Protect & PAGE_EXECUTE_READ || mbi.Protect & PAGE_EXECUTE_READWRITE)) {
-
-            std::vector<uint8_t> buffer(mbi.RegionSize);
-            SIZE_T bytesRead;
-
-            if (ReadProcessMemory(processHandle, mbi.BaseAddress, buffer.data(), mbi.RegionSize, &bytesRead)) {
-                for (size_t i = 0; i < buffer.size() - 10; i++) {
-                    if (buffer[i] == 0x48 && buffer[i + 1] == 0x8B && buffer[i + 2] == 0x0D &&
-                        buffer[i + 7] == 0x48 && buffer[i + 8] == 0x85 && buffer[i + 9] == 0xC9) {
-
-                        uintptr_t instructionAddr = (uintptr_t)mbi.BaseAddress + i;
-                        int32_t offset = *(int32_t*)(buffer.data() + i + 3);
-                        uWorld = instructionAddr + offset + 7;
-                        return true;
-                    }
-                }
-            }
-        }
-        addr += mbi.RegionSize;
-    }
-    return false;
+bool MemoryReader::CaptureSnapshot(const char* path) {
+    // Straight from the source, past this frame's cached lines
+    return backend && SnapshotBackend::Capture(cache->Inner(), moduleBase, kModuleName, path);
 }
 
-uintptr_t MemoryReader::GetModuleBaseAddress(DWORD processId, const wchar_t* moduleName) {
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, processId);
-    if (snapshot == INVALID_HANDLE_VALUE) return 0;
-
-    MODULEENTRY32W moduleEntry;
-    moduleEntry.dwSize = sizeof(moduleEntry);
+bool MemoryReader::FindUWorld() {
+    ScopedTimer timer(Stage::Scan);
+
+    // mov rcx, [rip + GWorld]; test rcx, rcx
+    SignatureScanner scanner;
+    size_t uWorldSignature = scanner.Add("48 8B 0D ?? ?? ?? ?? 48 85 C9");
+
+    // A cache written for this exact build only needs each hit re-checked
+    ModuleIdentity identity;
+    SignatureCache cache;
+    bool cacheable = identity.Read(*backend, moduleBase);
+    if (cacheable && cache.Load(kSignatureCachePath, identity))
+        cache.Apply(scanner, *backend, moduleBase);
+
+    if (!scanner.AllFound()) {
+        // The scan stays inside the image; without its headers there are no bounds
+        if (!cacheable) {
+            LOG_ERROR("Failed to read the module headers");
+            return false;
+        }
+        WorkStealingPool pool;
+        if (!scanner.ScanModuleParallel(*backend, moduleBase, identity.imageSize, pool)) return false;
 
-    if (Module32FirstW(snapshot, &moduleEntry)) {
-        do {
-            if (_wcsicmp(moduleEntry.szModule, moduleName) == 0) {
-                CloseHandle(snapshot);
-                return (uintptr_t)moduleEntry.modBaseAddr;
-            }
-        } while (Module32NextW(snapshot, &moduleEntry));
+        if (cacheable) {
+            cache.SetIdentity(identity);
+            cache.Update(scanner, moduleBase);
+            cache.Save(kSignatureCachePath);
+        }
     }
 
-    CloseHandle(snapshot);
-    return 0;
+    uintptr_t instructionAddr = scanner.Match(uWorldSignature);
+    int32_t offset = Read<int32_t>(instructionAddr + 3);
+    uWorld = instructionAddr + offset + 7;
+    return true;
 }
 
-std::vector<GameObject> MemoryReader::GetObjects() {
-    std::vector<GameObject> objects;
-    char debug[256];
-
-    sprintf_s(debug, "UWorld: 0x%llX", uWorld);
-    MessageBoxA(NULL, debug, "Debug - GetObjects", MB_OK);
-
-    uintptr_t uLevel;
-    ReadProcessMemory(processHandle, (LPCVOID)(uWorld + 0x30), &uLevel, sizeof(uLevel), nullptr);
-
-    sprintf_s(debug, "ULevel: 0x%llX", uLevel);
-    MessageBoxA(NULL, debug, "Debug - GetObjects", MB_OK);
-
-    uintptr_t actorArray;
-    int32_t actorCount;
-    ReadProcessMemory(processHandle, (LPCVOID)(uLevel + 0x98), &actorArray, sizeof(actorArray), nullptr);
-    ReadProcessMemory(processHandle, (LPCVOID)(uLevel + 0xA0), &actorCount, sizeof(actorCount), nullptr);
+void MemoryReader::GetObjects(EntityStore& out) {
+    ScopedTimer timer(Stage::ActorRead);
+    out.Resize(0);
+    arena.Reset();
+    // Lines cached last frame are stale; GetViewMatrix shares this frame's
+    cache->NextGeneration();
+    // Every call is a frame for the classifier's eviction, resolving or not
+    classifier.EndFrame();
+
+    // A new level reuses none of the old one's actors; start the table over.
+    // A failed read (null) is not a level change and just skips the frame
+    uintptr_t level = Read(uWorld, WorldLayout::PersistentLevel);
+    if (!level) return;
+    if (level != uLevel) {
+        tracker.Clear();
+        unresolved.clear();
+        retrying.clear();
+        uLevel = level;
+    }
 
-    sprintf_s(debug, "ActorArray: 0x%llX\nActorCount: %d", actorArray, actorCount);
-    MessageBoxA(NULL, debug, "Debug - GetObjects", MB_OK);
+    // ULevel::Actors header (data, count, max) in one read
+    ObjectView<LevelLayout> levelView;
+    levelView.Read(*backend, uLevel);
+    uintptr_t actorArray = levelView.Get(LevelLayout::ActorData);
+    int32_t actorCount = levelView.Get(LevelLayout::ActorCount);
+    int32_t actorMax = levelView.Get(LevelLayout::ActorMax);
+
+    WSS_LOG_LIMITED(LogLevel::Debug, "UWorld: 0x%llX, ULevel: 0x%llX, ActorArray: 0x%llX, ActorCount: %d",
+        (unsigned long long)uWorld, (unsigned long long)uLevel, (unsigned long long)actorArray, actorCount);
+
+    if (!actorArray || actorCount <= 0) return;
+    if ((size_t)actorCount > actorLimit || actorCount > actorMax) {
+        WSS_LOG_LIMITED(LogLevel::Warning, "Implausible actor count %d (max %d, limit %zu)",
+            actorCount, actorMax, actorLimit);
+        return;
+    }
 
-    for (int i = 0; i < actorCount && i < 1000; i++) {
-        uintptr_t actor;
-        ReadProcessMemory(processHandle, (LPCVOID)(actorArray + i * 8), &actor, sizeof(actor), nullptr);
+    // Stream the pointer block chunk by chunk; chunks that match last frame's
+    // cost a memcmp, and only changed slots are diffed against the tracker
+    streamArray = actorArray;
+    streamCount = (size_t)actorCount;
+    size_t chunks = (streamCount + kActorChunk - 1) / kActorChunk;
+    tracker.BeginUpdate(streamCount);
+    ReadActorChunk(0);
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        if (chunk + 1 < chunks)
+            prefetch->Submit([this, chunk](size_t) { ReadActorChunk(chunk + 1); });
+
+        size_t first = chunk * kActorChunk;
+        if (actorChunkRead[chunk & 1])
+            tracker.UpdateChunk(first, actorChunks[chunk & 1].data(), (std::min)(kActorChunk, streamCount - first));
+        prefetch->Wait();
+    }
 
-        if (actor != 0) {
-            char name[256] = { 0 };
-            uintptr_t namePtr;
-            ReadProcessMemory(processHandle, (LPCVOID)(actor + 0x18), &namePtr, sizeof(namePtr), nullptr);
-            ReadProcessMemory(processHandle, (LPCVOID)namePtr, name, sizeof(name), nullptr);
+    if (tracker.EndUpdate())
+        unresolved.insert(unresolved.end(), tracker.Added().begin(), tracker.Added().end());
+
+    // Resolve at most kResolveBudget actors per frame: up to kRetryBudget
+    // earlier failures, oldest first, then new actors, newest first. The rest
+    // wait as Unknown entities, and ones that vanished meanwhile are dropped
+    size_t resolveCount = 0;
+    uintptr_t* resolving = arena.Allocate<uintptr_t>((std::min)(unresolved.size() + retrying.size(), kResolveBudget));
+    while (!retrying.empty() && resolveCount < kRetryBudget) {
+        if (tracker.Contains(retrying.back())) resolving[resolveCount++] = retrying.back();
+        retrying.pop_back();
+    }
+    while (!unresolved.empty() && resolveCount < kResolveBudget) {
+        if (tracker.Contains(unresolved.back())) resolving[resolveCount++] = unresolved.back();
+        unresolved.pop_back();
+    }
 
-            if (strstr(name, "BP_Survivor") || strstr(name, "BP_Animal")) {
-                GameObject obj;
+    if (resolveCount) {
+        ScopedTimer classifyTimer(Stage::Classify);
+
+        // One batch per dependency level: each actor's covering span (name
+        // pointer and root component), then names for unclassified ones
+        auto* actorViews = arena.Allocate<ObjectView<ActorLayout>>(resolveCount);
+        planner.Reset();
+        for (size_t i = 0; i < resolveCount; i++) actorViews[i].Plan(planner, resolving[i]);
+        planner.Execute(*backend);
+
+        // A failed read is retried next frame rather than resolved (and cached) as Unknown
+        uintptr_t* namePtrs = arena.Allocate<uintptr_t>(resolveCount);
+        uintptr_t* rootComponents = arena.Allocate<uintptr_t>(resolveCount);
+        bool* failed = arena.Allocate<bool>(resolveCount);
+        for (size_t i = 0; i < resolveCount; i++) {
+            namePtrs[i] = actorViews[i].Get(ActorLayout::Name);
+            rootComponents[i] = actorViews[i].Get(ActorLayout::RootComponent);
+            failed[i] = !planner[i].ok;
+        }
 
-                uintptr_t rootComponent;
-                ReadProcessMemory(processHandle, (LPCVOID)(actor + 0x130), &rootComponent, sizeof(rootComponent), nullptr);
+        ActorCategory* categories = arena.Allocate<ActorCategory>(resolveCount);
+        uint32_t* unclassified = arena.Allocate<uint32_t>(resolveCount);
+        size_t unclassifiedCount = 0;
+        for (size_t i = 0; i < resolveCount; i++) {
+            categories[i] = ActorCategory::Unknown;
+            if (!failed[i] && namePtrs[i] && !classifier.Lookup(resolving[i], namePtrs[i], categories[i]))
+                unclassified[unclassifiedCount++] = (uint32_t)i;
+        }
 
-                ReadProcessMemory(processHandle, (LPCVOID)(rootComponent + 0x11C), &obj.position, sizeof(XMFLOAT3), nullptr);
+        char* names = arena.Allocate<char>(unclassifiedCount * (kNameLength + 1));
+        memset(names, 0, unclassifiedCount * (kNameLength + 1));
+        planner.Reset();
+        for (size_t slot = 0; slot < unclassifiedCount; slot++)
+            planner.Add(namePtrs[unclassified[slot]], &names[slot * (kNameLength + 1)], kNameLength);
+        planner.Execute(*backend);
+
+        for (size_t slot = 0; slot < unclassifiedCount; slot++) {
+            uint32_t i = unclassified[slot];
+            if (!planner[slot].ok) {
+                failed[i] = true;
+                continue;
+            }
+            categories[i] = ClassifyName(&names[slot * (kNameLength + 1)]);
+            classifier.Store(resolving[i], namePtrs[i], categories[i]);
+        }
 
-                obj.dimensions = XMFLOAT3(100.0f, 100.0f, 200.0f);
-                obj.isValid = true;
+        // Failures queue behind the other retries, so a few that keep failing
+        // neither starve new actors nor each other
+        uintptr_t* failures = arena.Allocate<uintptr_t>(resolveCount);
+        size_t failureCount = 0;
+        for (size_t i = 0; i < resolveCount; i++) {
+            if (failed[i]) failures[failureCount++] = resolving[i];
+            else tracker.Track(resolving[i], rootComponents[i], categories[i]);
+        }
+        retrying.insert(retrying.begin(), failures, failures + failureCount);
+    }
 
-                objects.push_back(obj);
-            }
+    // Hot fields: one batch of positions for the entities the scheduler picked
+    scheduler.Select(tracker, refresh);
+    planner.Reset();
+    Vec3* lastPositions = arena.Allocate<Vec3>(refresh.size());
+    for (size_t i = 0; i < refresh.size(); i++) {
+        ActorTracker::Entity& entity = tracker[refresh[i]];
+        lastPositions[i] = entity.position;
+        planner.Add(entity.rootComponent + SceneComponentLayout::RelativeLocation.offset, &entity.position);
+    }
+    uint64_t readStart = SampleClock();
+    planner.Execute(*backend);
+    // Stamp with the middle of the batch, the best guess at when the game state was seen
+    uint64_t sampleTime = readStart + (SampleClock() - readStart) / 2;
+    for (size_t i = 0; i < refresh.size(); i++) {
+        ActorTracker::Entity& entity = tracker[refresh[i]];
+        // A failed read zeroed the position (actor freed, component swapped);
+        // keep the last sample and the urgency, so it is retried next frame
+        if (!planner[i].ok) {
+            entity.position = lastPositions[i];
+            continue;
+        }
+        if (entity.sampleTime) {
+            float seconds = (sampleTime - entity.sampleTime) / 1e9f;
+            entity.velocity = { (entity.position.x - lastPositions[i].x) / seconds,
+                (entity.position.y - lastPositions[i].y) / seconds, (entity.position.z - lastPositions[i].z) / seconds };
         }
+        entity.sampleTime = sampleTime;
+        entity.urgency = 0.0f;
     }
 
-    return objects;
+    out.Resize(tracker.Size());
+    size_t count = 0;
+    for (const ActorTracker::Entity& entity : tracker) {
+        // Resolved but never positioned (not picked yet, or its first read failed) would draw at the origin
+        if (entity.category == ActorCategory::Unknown || !entity.sampleTime) continue;
+
+        out.ids[count] = entity.id;
+        out.SetPosition(count, entity.position);
+        out.extents[count] = Vec3{ 100.0f, 100.0f, 200.0f };
+        out.categories[count] = entity.category;
+        out.flags[count] = kEntityValid | (entity.sampleTime == sampleTime ? kEntityRefreshed : 0);
+        out.sampleTimes[count] = entity.sampleTime;
+        count++;
+    }
+    out.Resize(count);
 }
 
-XMMATRIX MemoryReader::GetViewMatrix() {
-    uintptr_t gameInstance, playerController, playerCameraManager;
-    ReadProcessMemory(processHandle, (LPCVOID)(uWorld + 0x180), &gameInstance, sizeof(gameInstance), nullptr);
-    ReadProcessMemory(processHandle, (LPCVOID)(gameInstance + 0x38), &playerController, sizeof(playerController), nullptr);
-    ReadProcessMemory(processHandle, (LPCVOID)(playerController + 0x2B8), &playerCameraManager, sizeof(playerCameraManager), nullptr);
-
-    XMMATRIX viewMatrix;
-    ReadProcessMemory(processHandle, (LPCVOID)(playerCameraManager + 0x1F0), &viewMatrix, sizeof(XMMATRIX), nullptr);
+void MemoryReader::ReadActorChunk(size_t chunk) {
+    size_t first = chunk * kActorChunk;
+    size_t count = (std::min)(kActorChunk, streamCount - first);
+    std::vector<uintptr_t>& buffer = actorChunks[chunk & 1];
+    buffer.resize(kActorChunk);
+    actorChunkRead[chunk & 1] = backend->Read(streamArray + first * sizeof(uintptr_t), buffer.data(), count * sizeof(uintptr_t));
+}
 
-    return viewMatrix;
+Matrix4 MemoryReader::GetViewMatrix() {
+    Matrix4 view = viewChain.Read<Matrix4>(*backend, uWorld);
+    scheduler.SetCamera(view, GetProjectionMatrix());
+    return view;
 }
 
-XMMATRIX MemoryReader::GetProjectionMatrix() {
+Matrix4 MemoryReader::GetProjectionMatrix() {
     float fovAngle = 90.0f;
     float width = 1920.0f;
     float height = 1080.0f;
-
-    return XMMatrixPerspectiveFovLH(
-        (fovAngle * 0.017453292f),
-        width / height,
-        0.1f,
-        1000.0f
-    );
-}
\ No newline at end of file
+    float nearZ = 0.1f;
+    float farZ = 1000.0f;
+
+    // Same matrix XMMatrixPerspectiveFovLH builds
+    float yScale = 1.0f / tanf(fovAngle * 0.017453292f * 0.5f);
+    float xScale = yScale / (width / height);
+    float range = farZ / (farZ - nearZ);
+
+    Matrix4 projection = {};
+    projection.m[0][0] = xScale;
+    projection.m[1][1] = yScale;
+    projection.m[2][2] = range;
+    projection.m[2][3] = 1.0f;
+    projection.m[3][2] = -range * nearZ;
+    return projection;
+}
@@ -1,38 +1,101 @@
 #pragma once
-#include <Windows.h>
-#include <TlHelp32.h>
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <DirectXMath.h>
-
-using namespace DirectX;
-
-struct GameObject {
-    XMFLOAT3 position;
-    XMFLOAT3 dimensions;
-    bool isValid;
-};
+#include "arena.h"
+#include "backend.h"
+#include "classify.h"
+#include "entitystore.h"
+#include "pagecache.h"
+#include "pointerchain.h"
+#include "readplanner.h"
+#include "scheduler.h"
+#include "schema.h"
+#include "threadpool.h"
+#include "tracker.h"
+#include "types.h"
 
 class MemoryReader {
 public:
+    static constexpr const char* kModuleName = "WSS-Win64-Shipping.exe";
+    static constexpr const char* kSignatureCachePath = "signatures.cache";
+    // Actor pointers read per chunk of the level's actor array
+    static constexpr size_t kActorChunk = 4096;
+    static constexpr size_t kDefaultActorLimit = 1 << 18;
+    // New actors whose name and root component are resolved per frame
+    static constexpr size_t kResolveBudget = 1024;
+    // Share of that budget for actors whose resolve reads failed before
+    static constexpr size_t kRetryBudget = 64;
+
+    // Attaches to the running game.
     bool Initialize();
-    std::vector<GameObject> GetObjects();
-    XMMATRIX GetViewMatrix();
-    XMMATRIX GetProjectionMatrix();
+    // Runs against any backend, e.g. a SnapshotBackend replaying a capture.
+    bool Initialize(std::unique_ptr<MemoryBackend> source);
+
+    // Refills out with every classified entity; out keeps its storage between calls.
+    void GetObjects(EntityStore& out);
+    Matrix4 GetViewMatrix();
+    Matrix4 GetProjectionMatrix();
+
+    // Actor counts above this are treated as a bad read rather than a level.
+    void SetActorLimit(size_t limit) { actorLimit = limit; }
+    // Positions re-read per GetObjects; the rest keep their last sample.
+    void SetReadBudget(size_t reads) { scheduler.SetBudget(reads); }
+
+    // Dumps the attached process into a snapshot file for offline replay.
+    // Uses the backend like GetObjects, so call it from the sampling thread.
+    bool CaptureSnapshot(const char* path);
+
+    MemoryBackend* Backend() { return backend.get(); }
+    // Per-frame line cache in front of the source; off until the first GetObjects.
+    PageCache& Cache() { return *cache; }
+    // Every actor of the current level by stable id, as of the last GetObjects.
+    const ActorTracker& Entities() const { return tracker; }
 
 private:
-    HANDLE processHandle;
-    uintptr_t moduleBase;
-    uintptr_t unityPlayerBase;
+    std::unique_ptr<MemoryBackend> backend;  // the source, wrapped in cache
+    PageCache* cache = nullptr;
+    uintptr_t moduleBase = 0;
+    uintptr_t unityPlayerBase = 0;
     uintptr_t objectListPtr = 0;
     uintptr_t uWorld = 0;
+    uintptr_t uLevel = 0;  // level the tracker's entities belong to
+    size_t actorLimit = kDefaultActorLimit;
+
+    // UWorld -> GameInstance -> PlayerController -> PlayerCameraManager -> view matrix
+    PointerChain viewChain{ { WorldLayout::OwningGameInstance.offset, GameInstanceLayout::PlayerController.offset,
+        PlayerControllerLayout::PlayerCameraManager.offset, CameraManagerLayout::ViewMatrix.offset } };
+
+    // Per-frame scratch for GetObjects: planner and pointer chunks keep their
+    // storage, everything sized by the frame comes from the arena
+    FrameArena arena;
+    ReadPlanner planner;
+    ActorClassifier classifier;
+    ActorTracker tracker;
+    RefreshScheduler scheduler;
+    // The actor array is streamed through two chunk buffers; the prefetch
+    // worker reads the next chunk while the current one is diffed
+    std::unique_ptr<WorkStealingPool> prefetch;
+    std::vector<uintptr_t> actorChunks[2];
+    bool actorChunkRead[2] = {};  // a failed chunk is skipped, so its slots keep last frame's actors
+    uintptr_t streamArray = 0;
+    size_t streamCount = 0;
+    std::vector<uintptr_t> unresolved;  // added actors still waiting for their first resolve
+    std::vector<uintptr_t> retrying;    // actors whose resolve failed, oldest at the back
+    std::vector<uint32_t> refresh;
 
-    uintptr_t GetModuleBaseAddress(DWORD processId, const wchar_t* moduleName);
     bool FindUWorld();
+    void ReadActorChunk(size_t chunk);
 
     template<typename T>
     T Read(uintptr_t address) {
         T value{};
-        ReadProcessMemory(processHandle, (LPCVOID)address, &value, sizeof(T), nullptr);
+        backend->Read(address, &value, sizeof(T));
         return value;
     }
-};
\ No newline at end of file
+
+    template<typename T>
+    T Read(uintptr_t object, Field<T> field) {
+        return Read<T>(object + field.offset);
+    }
+};
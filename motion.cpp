@@ -0,0 +1,121 @@
+/*
+* File: motion.cpp
+* Render-side motion prediction for Winter Survival ESP
+*/
+
+#include "motion.h"
+#include <algorithm>
+#include <cmath>
+
+void MotionPredictor::IndexTracks() {
+    size_t count = predicted.entities.Size();
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+    trackById.assign(capacity, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t id = predicted.entities.ids[i];
+        size_t slot = (id * 2654435761u) & (capacity - 1);
+        while (trackById[slot]) slot = (slot + 1) & (capacity - 1);
+        trackById[slot] = (uint64_t)id << 32 | i;
+    }
+}
+
+uint32_t MotionPredictor::FindTrack(uint32_t id) const {
+    size_t mask = trackById.size() - 1;
+    for (size_t slot = (id * 2654435761u) & mask; trackById[slot]; slot = (slot + 1) & mask) {
+        if ((uint32_t)(trackById[slot] >> 32) == id) return (uint32_t)trackById[slot];
+    }
+    return UINT32_MAX;
+}
+
+void MotionPredictor::Ingest(const WorldSnapshot& sample) {
+    if (lastTimestamp && sample.timestamp > lastTimestamp) {
+        uint64_t interval = sample.timestamp - lastTimestamp;
+        sampleInterval = sampleInterval ? (sampleInterval * 7 + interval) / 8 : interval;
+    }
+    lastTimestamp = sample.timestamp;
+
+    // Carry tracks over by entity id; entities that vanished are dropped
+    IndexTracks();
+
+    const EntityStore& entities = sample.entities;
+    nextTracks.resize(entities.Size());
+    for (size_t i = 0; i < entities.Size(); i++) {
+        Vec3 position = entities.Position(i);
+        uint64_t sampleTime = entities.sampleTimes[i];
+        Track& track = nextTracks[i];
+
+        uint32_t previous = FindTrack(entities.ids[i]);
+        if (previous == UINT32_MAX) {
+            track = { position, position, Vec3{ 0.0f, 0.0f, 0.0f }, sampleTime, sampleTime };
+            continue;
+        }
+
+        track = tracks[previous];
+        if (sampleTime <= track.time) continue;  // not re-read since the last snapshot
+
+        float seconds = (sampleTime - track.time) / 1e9f;
+        Vec3 moved = { (position.x - track.position.x) / seconds, (position.y - track.position.y) / seconds,
+            (position.z - track.position.z) / seconds };
+        float speed = sqrtf(moved.x * moved.x + moved.y * moved.y + moved.z * moved.z);
+
+        if (speed > settings.teleportSpeed) {
+            // Respawn or teleport: start over from the new position
+            track = { position, position, Vec3{ 0.0f, 0.0f, 0.0f }, sampleTime, sampleTime };
+            continue;
+        }
+
+        float blend = track.time == track.previousTime ? 1.0f : settings.velocitySmoothing;
+        track.velocity = { track.velocity.x + (moved.x - track.velocity.x) * blend,
+            track.velocity.y + (moved.y - track.velocity.y) * blend,
+            track.velocity.z + (moved.z - track.velocity.z) * blend };
+        track.previous = track.position;
+        track.previousTime = track.time;
+        track.position = position;
+        track.time = sampleTime;
+    }
+    tracks.swap(nextTracks);
+
+    predicted.entities = sample.entities;
+    predicted.index = sample.index;
+    predicted.view = sample.view;
+    predicted.projection = sample.projection;
+    predicted.timestamp = sample.timestamp;
+    predicted.sequence = sample.sequence;
+    sequence = sample.sequence;
+}
+
+const WorldSnapshot& MotionPredictor::Predict(const WorldSnapshot& sample, uint64_t now) {
+    if (sample.sequence != sequence) Ingest(sample);
+
+    for (size_t i = 0; i < tracks.size(); i++) {
+        const Track& track = tracks[i];
+        if (!track.time) continue;
+        Vec3 position;
+        uint64_t target = now;
+
+        if (settings.mode == Mode::Interpolate && track.previousTime < track.time) {
+            // One sample interval behind: between the last two samples while it lasts
+            uint64_t at = now > sampleInterval ? now - sampleInterval : 0;
+            if (at <= track.time) {
+                float t = at <= track.previousTime ? 0.0f
+                    : (float)(at - track.previousTime) / (float)(track.time - track.previousTime);
+                position = { track.previous.x + (track.position.x - track.previous.x) * t,
+                    track.previous.y + (track.position.y - track.previous.y) * t,
+                    track.previous.z + (track.position.z - track.previous.z) * t };
+                predicted.entities.SetPosition(i, position);
+                continue;
+            }
+            target = at;
+        }
+
+        uint64_t ahead = target > track.time ? (std::min)(target - track.time, settings.maxExtrapolation) : 0;
+        float seconds = ahead / 1e9f;
+        position = { track.position.x + track.velocity.x * seconds, track.position.y + track.velocity.y * seconds,
+            track.position.z + track.velocity.z * seconds };
+        predicted.entities.SetPosition(i, position);
+    }
+
+    return predicted;
+}
@@ -0,0 +1,62 @@
+/*
+* File: motion.h
+* Render-side motion prediction for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "world.h"
+
+// Carries each entity's last samples across snapshots and moves it to the
+// render time: constant-velocity extrapolation from its newest sample, or
+// interpolation between its last two samples one sample interval behind.
+// Extrapolation is clamped, and a jump faster than teleportSpeed resets the
+// entity to its new position with no velocity.
+class MotionPredictor {
+public:
+    enum class Mode {
+        Extrapolate,
+        Interpolate,
+    };
+
+    struct Settings {
+        Mode mode = Mode::Extrapolate;
+        uint64_t maxExtrapolation = 150000000;  // ns past the newest sample
+        float teleportSpeed = 10000.0f;         // units/s; UE units are cm
+        float velocitySmoothing = 0.5f;         // weight of the newest velocity estimate
+    };
+
+    void Configure(const Settings& newSettings) { settings = newSettings; }
+
+    // Takes in sample if it is new and returns it with every position moved
+    // to now (steady clock ns). The spatial index keeps the sampled positions.
+    const WorldSnapshot& Predict(const WorldSnapshot& sample, uint64_t now);
+
+    // Mean spacing of snapshot sample times, the interpolation delay.
+    uint64_t SampleInterval() const { return sampleInterval; }
+
+private:
+    struct Track {
+        Vec3 position;      // newest sample
+        Vec3 previous;      // sample before it
+        Vec3 velocity;      // units per second
+        uint64_t time;
+        uint64_t previousTime;
+    };
+
+    Settings settings;
+    WorldSnapshot predicted;
+    std::vector<Track> tracks;      // parallel to predicted.entities
+    std::vector<Track> nextTracks;
+    // Open-addressed id -> track index of the previous sample, (id << 32 | index)
+    // per slot with id 0 free; rebuilt in place so ingesting never allocates
+    std::vector<uint64_t> trackById;
+    uint64_t sequence = 0;
+    uint64_t lastTimestamp = 0;
+    uint64_t sampleInterval = 0;
+
+    void Ingest(const WorldSnapshot& sample);
+    void IndexTracks();
+    uint32_t FindTrack(uint32_t id) const;
+};
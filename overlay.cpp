@@ -4,6 +4,9 @@
 */
 
 #include "overlay.h"
+#include "logger.h"
+#include "profiler.h"
+#include "projection.h"
 #include <d3dcompiler.h>
 #include <dwmapi.h>
 #include <iostream>
@@ -11,7 +14,9 @@
 #pragma comment(lib, "d3dcompiler.lib")
 #pragma comment(lib, "dwmapi.lib")
 
-bool Overlay::Initialize() {
+using namespace DirectX;
+
+bool Overlay::Initialize(bool requireGame) {
     WNDCLASSEXA wc = { sizeof(WNDCLASSEX) };
     wc.lpfnWndProc = DefWindowProcA;
     wc.lpszClassName = "OverlayWindow";
@@ -19,8 +24,9 @@ bool Overlay::Initialize() {
     RegisterClassExA(&wc);
 
     gameWindow = FindWindowA(NULL, "WSS 64  ");
+    if (!gameWindow && !requireGame) gameWindow = GetDesktopWindow();
     if (!gameWindow) {
-        MessageBoxA(NULL, "Failed to find game window", "Debug", MB_OK);
+        LOG_ERROR("Failed to find game window");
         return false;
     }
 
@@ -40,7 +46,7 @@ bool Overlay::Initialize() {
         NULL);
 
     if (!overlayWindow) {
-        MessageBoxA(NULL, "Failed to create overlay window", "Debug", MB_OK);
+        LOG_ERROR("Failed to create overlay window");
         return false;
     }
 
@@ -52,7 +58,7 @@ bool Overlay::Initialize() {
     DwmExtendFrameIntoClientArea(overlayWindow, &margins);
 
     if (!InitializeDirectX()) {
-        MessageBoxA(NULL, "Failed to initialize DirectX", "Debug", MB_OK);
+        LOG_ERROR("Failed to initialize DirectX");
         return false;
     }
 
@@ -102,14 +108,14 @@ bool Overlay::InitializeDirectX() {
     );
 
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create D3D device", "Debug", MB_OK);
+        LOG_ERROR("Failed to create D3D device");
         return false;
     }
 
     ID3D11Texture2D* backBuffer;
     hr = swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer);
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to get back buffer", "Debug", MB_OK);
+        LOG_ERROR("Failed to get back buffer");
         return false;
     }
 
@@ -117,7 +123,7 @@ bool Overlay::InitializeDirectX() {
     backBuffer->Release();
 
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create render target", "Debug", MB_OK);
+        LOG_ERROR("Failed to create render target");
         return false;
     }
 
@@ -156,7 +162,7 @@ bool Overlay::InitializeDirectX() {
         "main", "vs_4_0", 0, 0, &vsBlob, &errorBlob);
     if (FAILED(hr)) {
         if (errorBlob) {
-            MessageBoxA(NULL, (char*)errorBlob->GetBufferPointer(), "Vertex Shader Error", MB_OK);
+            LOG_ERROR("Vertex shader error: %s", (const char*)errorBlob->GetBufferPointer());
             errorBlob->Release();
         }
         return false;
@@ -167,7 +173,7 @@ bool Overlay::InitializeDirectX() {
         "main", "ps_4_0", 0, 0, &psBlob, &errorBlob);
     if (FAILED(hr)) {
         if (errorBlob) {
-            MessageBoxA(NULL, (char*)errorBlob->GetBufferPointer(), "Pixel Shader Error", MB_OK);
+            LOG_ERROR("Pixel shader error: %s", (const char*)errorBlob->GetBufferPointer());
             errorBlob->Release();
         }
         vsBlob->Release();
@@ -176,7 +182,7 @@ bool Overlay::InitializeDirectX() {
 
     hr = device->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, &vertexShader);
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create vertex shader", "Error", MB_OK);
+        LOG_ERROR("Failed to create vertex shader");
         vsBlob->Release();
         psBlob->Release();
         return false;
@@ -184,7 +190,7 @@ bool Overlay::InitializeDirectX() {
 
     hr = device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &pixelShader);
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create pixel shader", "Error", MB_OK);
+        LOG_ERROR("Failed to create pixel shader");
         vsBlob->Release();
         psBlob->Release();
         return false;
@@ -197,7 +203,7 @@ bool Overlay::InitializeDirectX() {
 
     hr = device->CreateInputLayout(layout, 2, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &inputLayout);
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create input layout", "Error", MB_OK);
+        LOG_ERROR("Failed to create input layout");
         vsBlob->Release();
         psBlob->Release();
         return false;
@@ -220,13 +226,26 @@ bool Overlay::InitializeDirectX() {
     ID3D11BlendState* blendState;
     hr = device->CreateBlendState(&blendDesc, &blendState);
     if (FAILED(hr)) {
-        MessageBoxA(NULL, "Failed to create blend state", "Error", MB_OK);
+        LOG_ERROR("Failed to create blend state");
         return false;
     }
 
     context->OMSetBlendState(blendState, nullptr, 0xffffffff);
     blendState->Release();
 
+    // Persistent dynamic vertex buffer the draw list is streamed into each frame
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.ByteWidth = kVertexCapacity * sizeof(DrawVertex);
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    hr = device->CreateBuffer(&bufferDesc, nullptr, &vertexBuffer);
+    if (FAILED(hr)) {
+        LOG_ERROR("Failed to create vertex buffer");
+        return false;
+    }
+
     return true;
 }
 
@@ -251,107 +270,122 @@ void Overlay::BeginScene() {
         static_cast<float>(rect.bottom - rect.top),
         0.0f, 1.0f };
     context->RSSetViewports(1, &viewport);
-}
 
-void Overlay::Render(MemoryReader& memory) {
-    // Draw test box in bright red
-    DrawBox(XMFLOAT2(100.0f, 100.0f), 100.0f, 100.0f, XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f));
+    drawList.Begin(viewport.Width, viewport.Height);
 }
 
-void Overlay::EndScene() {
-    swapChain->Present(1, 0);
-}
-
-DirectX::XMFLOAT2 Overlay::WorldToScreen(const DirectX::XMFLOAT3& pos, const DirectX::XMMATRIX& viewProj) {
-    RECT rect;
-    GetClientRect(overlayWindow, &rect);
-    float width = (float)(rect.right - rect.left);
-    float height = (float)(rect.bottom - rect.top);
+void Overlay::Render(const WorldSnapshot& world) {
+    if (!world.sequence) return;
+
+    Matrix4 viewProj = Multiply(world.view, world.projection);
+    ProjectionParams params;
+    params.viewportWidth = drawList.ViewportWidth();
+    params.viewportHeight = drawList.ViewportHeight();
+    params.guardBand = 1.5f;  // keep boxes whose feet or head are just off screen
+
+    // The grid drops whole cells outside the (guard-banded) frustum; feet and
+    // heads of the rest are projected as one batch: feet in [0, n), heads in [n, 2n)
+    const EntityStore& entities = world.entities;
+    size_t count;
+    {
+        ScopedTimer timer(Stage::Projection);
+        world.index.Frustum(viewProj, params.guardBand, candidates);
+        count = candidates.size();
+        pointsX.resize(count * 2);
+        pointsY.resize(count * 2);
+        pointsZ.resize(count * 2);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t entity = candidates[i];
+            pointsX[i] = pointsX[count + i] = entities.x[entity];
+            pointsY[i] = pointsY[count + i] = entities.y[entity];
+            pointsZ[i] = entities.z[entity];
+            pointsZ[count + i] = entities.z[entity] + entities.extents[entity].z;
+        }
 
-    auto worldPos = XMVectorSet(pos.x, pos.y, pos.z, 1.0f);
-    auto transformed = XMVector3Transform(worldPos, viewProj);
+        screenX.resize(count * 2);
+        screenY.resize(count * 2);
+        screenIndices.resize(count * 2);
+        size_t visible = ProjectPoints(viewProj, params, pointsX.data(), pointsY.data(), pointsZ.data(), count * 2,
+            screenX.data(), screenY.data(), screenIndices.data());
+
+        footSlots.assign(count, UINT32_MAX);
+        headSlots.assign(count, UINT32_MAX);
+        for (size_t k = 0; k < visible; k++) {
+            uint32_t index = screenIndices[k];
+            if (index < count) footSlots[index] = (uint32_t)k;
+            else headSlots[index - count] = (uint32_t)k;
+        }
+    }
 
-    XMFLOAT4 clip;
-    XMStoreFloat4(&clip, transformed);
+    ScopedTimer drawTimer(Stage::DrawList);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t entity = candidates[i];
+        if (!(entities.flags[entity] & kEntityValid) || footSlots[i] == UINT32_MAX || headSlots[i] == UINT32_MAX) continue;
 
-    if (clip.w < 0.1f) return XMFLOAT2(-1, -1);
+        float footY = screenY[footSlots[i]];
+        float headX = screenX[headSlots[i]];
+        float headY = screenY[headSlots[i]];
 
-    float x = (clip.x / clip.w + 1.0f) * width / 2;
-    float y = (-clip.y / clip.w + 1.0f) * height / 2;
+        float height = footY - headY;
+        if (height < 0) height = -height;
+        const Vec3& extent = entities.extents[entity];
+        float width = height * (extent.x / extent.z);
 
-    return XMFLOAT2(x, y);
+        XMFLOAT4 color = entities.categories[entity] == ActorCategory::Survivor
+            ? XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f)
+            : XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+        DrawBox(XMFLOAT2(headX - width / 2, (headY < footY ? headY : footY)), width, height, color);
+    }
 }
 
-void Overlay::DrawBox(const DirectX::XMFLOAT2& screenPos, float width, float height, const DirectX::XMFLOAT4& color) {
-    struct Vertex {
-        XMFLOAT3 pos;
-        XMFLOAT4 color;
-    };
-
-    RECT rect;
-    GetClientRect(overlayWindow, &rect);
-    float windowWidth = (float)(rect.right - rect.left);
-    float windowHeight = (float)(rect.bottom - rect.top);
-
-    float normalizedX = (screenPos.x / windowWidth) * 2.0f - 1.0f;
-    float normalizedY = -(screenPos.y / windowHeight) * 2.0f + 1.0f;
-    float normalizedWidth = (width / windowWidth) * 2.0f;
-    float normalizedHeight = (height / windowHeight) * 2.0f;
-
-    float lineWidth = 2.0f / windowWidth; // 2 pixel line width
-
-    // Draw 4 lines for the box
-    Vertex vertices[] = {
-        // Top line
-        { XMFLOAT3(normalizedX, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX, normalizedY - lineWidth, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY - lineWidth, 0.0f), color },
-
-        // Right line
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY - normalizedHeight, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth - lineWidth, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth - lineWidth, normalizedY - normalizedHeight, 0.0f), color },
-
-        // Bottom line
-        { XMFLOAT3(normalizedX, normalizedY - normalizedHeight, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY - normalizedHeight, 0.0f), color },
-        { XMFLOAT3(normalizedX, normalizedY - normalizedHeight + lineWidth, 0.0f), color },
-        { XMFLOAT3(normalizedX + normalizedWidth, normalizedY - normalizedHeight + lineWidth, 0.0f), color },
-
-        // Left line
-        { XMFLOAT3(normalizedX, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX, normalizedY - normalizedHeight, 0.0f), color },
-        { XMFLOAT3(normalizedX + lineWidth, normalizedY, 0.0f), color },
-        { XMFLOAT3(normalizedX + lineWidth, normalizedY - normalizedHeight, 0.0f), color }
-    };
-
-    D3D11_BUFFER_DESC bufferDesc = {};
-    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-    bufferDesc.ByteWidth = sizeof(vertices);
-    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = vertices;
+void Overlay::EndScene() {
+    ScopedTimer timer(Stage::Present);
+    FlushDrawList();
+    // Vsync is off when the caller paces frames (FramePacer); waiting for
+    // vblank on top of that doubles the frame time
+    swapChain->Present(syncInterval, 0);
+}
 
-    ID3D11Buffer* vertexBuffer;
-    device->CreateBuffer(&bufferDesc, &initData, &vertexBuffer);
+void Overlay::FlushDrawList() {
+    const DrawVertex* data = drawList.Data();
+    UINT remaining = (UINT)drawList.VertexCount();
+    if (!remaining) return;
 
-    UINT stride = sizeof(Vertex);
+    UINT stride = sizeof(DrawVertex);
     UINT offset = 0;
     context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // Append behind what the GPU may still be reading; wrap with a discard when full.
+    // Lists larger than the buffer go out in several draws of whole triangles.
+    while (remaining) {
+        UINT count = remaining < kVertexCapacity ? remaining : kVertexCapacity;
+        D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+        if (vertexOffset + count > kVertexCapacity) {
+            mapType = D3D11_MAP_WRITE_DISCARD;
+            vertexOffset = 0;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        if (FAILED(context->Map(vertexBuffer, 0, mapType, 0, &mapped))) return;
+        memcpy((DrawVertex*)mapped.pData + vertexOffset, data, count * sizeof(DrawVertex));
+        context->Unmap(vertexBuffer, 0);
 
-    // Draw each line
-    for (int i = 0; i < 4; i++) {
-        context->Draw(4, i * 4);
+        context->Draw(count, vertexOffset);
+        vertexOffset += count;
+        data += count;
+        remaining -= count;
     }
+}
 
-    vertexBuffer->Release();
+void Overlay::DrawBox(const DirectX::XMFLOAT2& screenPos, float width, float height, const DirectX::XMFLOAT4& color) {
+    // 2 pixel outline, flushed with the rest of the frame in EndScene
+    drawList.AddBox(Vec2{ screenPos.x, screenPos.y }, width, height, 2.0f,
+        Vec4{ color.x, color.y, color.z, color.w });
 }
 
 void Overlay::CleanupDirectX() {
+    if (vertexBuffer) vertexBuffer->Release();
     if (inputLayout) inputLayout->Release();
     if (vertexShader) vertexShader->Release();
     if (pixelShader) pixelShader->Release();
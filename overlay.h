@@ -6,14 +6,20 @@
 #pragma once
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include <vector>
+#include "drawlist.h"
 #include "memory.h"
+#include "world.h"
 
 class Overlay {
 public:
-	bool Initialize();
+	// Without requireGame (replays) the overlay covers the desktop when the game is not running
+	bool Initialize(bool requireGame = true);
 	void BeginScene();
-	void Render(MemoryReader& memory);
+	void Render(const WorldSnapshot& world);
 	void EndScene();
+	// On (the default), Present waits for vblank; turn it off when FramePacer sets the rate
+	void SetVsync(bool on) { syncInterval = on ? 1 : 0; }
 	~Overlay();
 
 private:
@@ -27,8 +33,22 @@ private:
 	ID3D11PixelShader* pixelShader = nullptr;
 	ID3D11InputLayout* inputLayout = nullptr;
 
+	// The frame's geometry is batched here and streamed into one dynamic ring buffer
+	static constexpr UINT kVertexCapacity = 6 * 4 * 2048;
+	DrawList drawList;
+	ID3D11Buffer* vertexBuffer = nullptr;
+	UINT vertexOffset = kVertexCapacity;
+	UINT syncInterval = 1;
+
+	// Per-frame projection scratch (positions in SoA layout, compacted results)
+	std::vector<uint32_t> candidates;
+	std::vector<float> pointsX, pointsY, pointsZ;
+	std::vector<float> screenX, screenY;
+	std::vector<uint32_t> screenIndices;
+	std::vector<uint32_t> footSlots, headSlots;
+
 	bool InitializeDirectX();
 	void CleanupDirectX();
-	DirectX::XMFLOAT2 WorldToScreen(const DirectX::XMFLOAT3& pos, const DirectX::XMMATRIX& viewProj);
 	void DrawBox(const DirectX::XMFLOAT2& screenPos, float width, float height, const DirectX::XMFLOAT4& color);
+	void FlushDrawList();
 };
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*
+* File: pagecache.cpp
+* Generation-stamped cache of remote memory lines for Winter Survival ESP
+*/
+
+#include "pagecache.h"
+#include <algorithm>
+#include <cstring>
+
+static size_t RoundUpPow2(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+PageCache::PageCache(std::unique_ptr<MemoryBackend> inner) : inner(std::move(inner)) {
+    Configure(kDefaultLineSize, kDefaultLineCount);
+}
+
+void PageCache::Configure(size_t newLineSize, size_t lineCount) {
+    lineSize = RoundUpPow2((std::max)(newLineSize, (size_t)64));
+    lines.assign(RoundUpPow2((std::max)(lineCount, (size_t)1)), Line{ 0, 0 });
+    data.assign(lines.size() * lineSize, 0);
+}
+
+void PageCache::NextGeneration() {
+    generation++;
+}
+
+void PageCache::Pin(uintptr_t address, size_t size) {
+    pinned.push_back({ address, address + size });
+}
+
+void PageCache::Unpin() {
+    pinned.clear();
+}
+
+bool PageCache::Cacheable(uintptr_t address, size_t size) const {
+    // Reads as big as a line gain nothing from it; neither do pinned ones
+    if (!generation || size > lineSize / 2) return false;
+    for (const auto& range : pinned) {
+        if (address < range.second && address + size > range.first) return false;
+    }
+    return true;
+}
+
+const uint8_t* PageCache::Lookup(uintptr_t address) const {
+    uintptr_t tag = address & ~(uintptr_t)(lineSize - 1);
+    size_t slot = (tag / lineSize) & (lines.size() - 1);
+    const Line& line = lines[slot];
+    if (line.tag != tag || line.generation != generation) return nullptr;
+    return data.data() + slot * lineSize + (address - tag);
+}
+
+bool PageCache::Copy(uintptr_t address, void* buffer, size_t size) const {
+    // A read is at most half a line, so it spans one or two lines
+    size_t head = (std::min)(size, lineSize - (address & (lineSize - 1)));
+    const uint8_t* first = Lookup(address);
+    if (!first) return false;
+    if (head == size) {
+        memcpy(buffer, first, size);
+        return true;
+    }
+    const uint8_t* second = Lookup(address + head);
+    if (!second) return false;
+    memcpy(buffer, first, head);
+    memcpy((uint8_t*)buffer + head, second, size - head);
+    return true;
+}
+
+bool PageCache::Fill(uintptr_t lineAddress) {
+    size_t slot = (lineAddress / lineSize) & (lines.size() - 1);
+    Line& line = lines[slot];
+    if (line.tag == lineAddress && line.generation == generation) return true;
+
+    // An unreadable line (unmapped, or part of it is) is left uncached
+    line.generation = 0;
+    if (!inner->Read(lineAddress, data.data() + slot * lineSize, lineSize)) return false;
+    line.tag = lineAddress;
+    line.generation = generation;
+    return true;
+}
+
+bool PageCache::Read(uintptr_t address, void* buffer, size_t size) {
+    if (!Cacheable(address, size)) return inner->Read(address, buffer, size);
+
+    if (Copy(address, buffer, size)) {
+        hits++;
+        return true;
+    }
+
+    misses++;
+    uintptr_t first = address & ~(uintptr_t)(lineSize - 1);
+    uintptr_t last = (address + size - 1) & ~(uintptr_t)(lineSize - 1);
+    // Two lines may map to the same slot; then only the first stays cached
+    if (Fill(first) && (last == first || Fill(last)) && Copy(address, buffer, size)) return true;
+    return inner->Read(address, buffer, size);
+}
+
+size_t PageCache::ReadBatch(ReadRequest* requests, size_t count) {
+    // Current lines serve what they can; the rest go out as one batch, as
+    // they would have without the cache. Batches are scattered reads, so
+    // fetching a whole line for each would mostly cost bytes
+    forwarded.clear();
+    forwardedIndex.clear();
+    size_t succeeded = 0;
+    for (size_t i = 0; i < count; i++) {
+        ReadRequest& request = requests[i];
+        if (Cacheable(request.address, request.size)) {
+            if (Copy(request.address, request.buffer, request.size)) {
+                request.ok = true;
+                succeeded++;
+                hits++;
+                continue;
+            }
+            misses++;
+        }
+        forwarded.push_back(request);
+        forwardedIndex.push_back((uint32_t)i);
+    }
+    if (forwarded.empty()) return succeeded;
+
+    succeeded += inner->ReadBatch(forwarded.data(), forwarded.size());
+    for (size_t i = 0; i < forwarded.size(); i++) requests[forwardedIndex[i]].ok = forwarded[i].ok;
+    return succeeded;
+}
+
+bool PageCache::Query(uintptr_t address, MemoryRegion& region) {
+    return inner->Query(address, region);
+}
+
+uintptr_t PageCache::ModuleBase(const char* moduleName) {
+    return inner->ModuleBase(moduleName);
+}
+
+const uint8_t* PageCache::View(uintptr_t address, size_t size) {
+    return inner->View(address, size);
+}
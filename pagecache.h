@@ -0,0 +1,78 @@
+/*
+* File: pagecache.h
+* Generation-stamped cache of remote memory lines for Winter Survival ESP
+*/
+
+#pragma once
+#include "backend.h"
+#include <memory>
+#include <vector>
+
+// Sits between MemoryReader and the real backend and keeps recently read
+// remote lines (4 KiB by default, i.e. one page) locally. A small Read that
+// misses fetches its whole line, so later reads of neighbouring fields and
+// objects in the same frame are local copies. NextGeneration() invalidates
+// every line at once; call it per frame. Pinned ranges are never cached, for
+// data that must be fresh on every read.
+//
+// The cache is off (every call passes straight through) until the first
+// NextGeneration(), so parallel signature scans never touch it. Once on,
+// cached reads must come from one thread at a time.
+class PageCache : public MemoryBackend {
+public:
+    static constexpr size_t kDefaultLineSize = 4096;
+    static constexpr size_t kDefaultLineCount = 256;
+
+    explicit PageCache(std::unique_ptr<MemoryBackend> inner);
+
+    // Both are rounded up to powers of two; drops everything cached.
+    void Configure(size_t lineSize, size_t lineCount);
+    void NextGeneration();
+
+    // Reads touching [address, address + size) always go to the backend.
+    void Pin(uintptr_t address, size_t size);
+    void Unpin();
+
+    bool Read(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(ReadRequest* requests, size_t count) override;
+    bool Query(uintptr_t address, MemoryRegion& region) override;
+    uintptr_t ModuleBase(const char* moduleName) override;
+    const uint8_t* View(uintptr_t address, size_t size) override;
+
+    // Remote traffic is what the wrapped backend issued
+    uint64_t ReadCalls() const override { return inner->ReadCalls(); }
+    uint64_t ReadBytes() const override { return inner->ReadBytes(); }
+
+    MemoryBackend& Inner() { return *inner; }
+    size_t LineSize() const { return lineSize; }
+    size_t LineCount() const { return lines.size(); }
+
+    // Reads served locally, and reads that had to go remote while the cache was on.
+    uint64_t Hits() const { return hits; }
+    uint64_t Misses() const { return misses; }
+    void ResetStats() { hits = misses = 0; }
+
+private:
+    struct Line {
+        uintptr_t tag;        // line address
+        uint64_t generation;  // valid while equal to the current generation
+    };
+
+    std::unique_ptr<MemoryBackend> inner;
+    size_t lineSize = 0;
+    std::vector<Line> lines;     // direct-mapped by line address
+    std::vector<uint8_t> data;   // lineSize bytes per line
+    std::vector<std::pair<uintptr_t, uintptr_t>> pinned;
+    uint64_t generation = 0;     // 0 while off
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    std::vector<ReadRequest> forwarded;
+    std::vector<uint32_t> forwardedIndex;
+
+    bool Cacheable(uintptr_t address, size_t size) const;
+    // Local copy of the line holding address if it is current, nullptr otherwise
+    const uint8_t* Lookup(uintptr_t address) const;
+    bool Copy(uintptr_t address, void* buffer, size_t size) const;
+    bool Fill(uintptr_t lineAddress);
+};
@@ -0,0 +1,70 @@
+/*
+* File: pointerchain.cpp
+* Cached multi-hop pointer resolution for Winter Survival ESP
+*/
+
+#include "pointerchain.h"
+#include <cstring>
+
+PointerChain::PointerChain(std::initializer_list<uint32_t> list, uint32_t revalidateInterval)
+    : revalidateInterval(revalidateInterval) {
+    for (uint32_t offset : list) {
+        if (count == kMaxHops) break;
+        offsets[count++] = offset;
+    }
+}
+
+bool PointerChain::Walk(MemoryBackend& backend, uintptr_t base) {
+    // Dependent reads from the first stale hop to the last pointer
+    for (size_t hop = resolved; hop + 1 < count; hop++) {
+        hopsWalked++;
+        if (!backend.Read(HopAddress(base, hop), &hops[hop], sizeof(uintptr_t)) || !hops[hop]) {
+            resolved = hop;
+            return false;
+        }
+    }
+    resolved = count - 1;
+    return true;
+}
+
+void PointerChain::Revalidate(MemoryBackend& backend, uintptr_t base) {
+    // Each cached hop's address is known, so they are all re-read in one round-trip
+    uintptr_t fresh[kMaxHops];
+    ReadRequest requests[kMaxHops];
+    for (size_t hop = 0; hop < resolved; hop++)
+        requests[hop] = { HopAddress(base, hop), &fresh[hop], sizeof(uintptr_t), false };
+    backend.ReadBatch(requests, resolved);
+    revalidations++;
+
+    for (size_t hop = 0; hop < resolved; hop++) {
+        if (!requests[hop].ok || fresh[hop] != hops[hop]) {
+            resolved = hop;
+            break;
+        }
+    }
+}
+
+bool PointerChain::Read(MemoryBackend& backend, uintptr_t base, void* buffer, size_t size) {
+    if (!count) return false;
+
+    if (base != cachedBase) {
+        cachedBase = base;
+        resolved = 0;
+    }
+    if (resolved && ++sinceRevalidate >= revalidateInterval) {
+        sinceRevalidate = 0;
+        Revalidate(backend, base);
+    }
+
+    if (resolved < count - 1 && !Walk(backend, base)) {
+        memset(buffer, 0, size);
+        return false;
+    }
+
+    uintptr_t address = HopAddress(base, count - 1);
+    if (backend.Read(address, buffer, size)) return true;
+
+    // The object moved or was freed; walk the chain again next time
+    resolved = 0;
+    return false;
+}
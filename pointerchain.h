@@ -0,0 +1,56 @@
+/*
+* File: pointerchain.h
+* Cached multi-hop pointer resolution for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include "backend.h"
+
+// Follows base -> [base + o0] -> [p1 + o1] -> ... and reads the last field at
+// p(n-1) + o(n-1). The intermediate pointers are cached: a steady-state Read
+// is one remote read of the field. Every revalidateInterval reads (or after
+// a failed read) all cached hops are re-read in one batch, and the chain is
+// walked again only from the first hop that changed.
+class PointerChain {
+public:
+    static constexpr size_t kMaxHops = 8;
+
+    PointerChain(std::initializer_list<uint32_t> offsets, uint32_t revalidateInterval = 60);
+
+    bool Read(MemoryBackend& backend, uintptr_t base, void* buffer, size_t size);
+
+    template<typename T>
+    T Read(MemoryBackend& backend, uintptr_t base) {
+        T value{};
+        Read(backend, base, &value, sizeof(T));
+        return value;
+    }
+
+    // Forces a full walk on the next Read.
+    void Invalidate() { resolved = 0; }
+
+    // Hops walked one by one (dependent reads) and batch revalidations so far.
+    uint64_t HopsWalked() const { return hopsWalked; }
+    uint64_t Revalidations() const { return revalidations; }
+
+private:
+    uint32_t offsets[kMaxHops];
+    uintptr_t hops[kMaxHops];  // hops[i] = pointer read at (i ? hops[i - 1] : base) + offsets[i]
+    size_t count = 0;          // offsets; the last one addresses the field, not a pointer
+    size_t resolved = 0;       // leading hops known to be current
+    uintptr_t cachedBase = 0;
+
+    uint32_t revalidateInterval;
+    uint32_t sinceRevalidate = 0;
+    uint64_t hopsWalked = 0;
+    uint64_t revalidations = 0;
+
+    uintptr_t HopAddress(uintptr_t base, size_t hop) const {
+        return (hop ? hops[hop - 1] : base) + offsets[hop];
+    }
+    bool Walk(MemoryBackend& backend, uintptr_t base);
+    void Revalidate(MemoryBackend& backend, uintptr_t base);
+};
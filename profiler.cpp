@@ -0,0 +1,219 @@
+/*
+* File: profiler.cpp
+* Hot-path instrumentation for Winter Survival ESP
+*/
+
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+struct TraceEvent {
+    uint64_t start;
+    uint64_t duration;
+    uint32_t thread;
+    Stage stage;
+};
+
+struct FrameEvent {
+    uint64_t time;
+    uint64_t reads;
+    uint64_t bytes;
+};
+
+constexpr size_t kTraceCapacity = 1 << 18;
+constexpr size_t kFrameCapacity = 1 << 16;
+
+LatencyHistogram stageLatency[(size_t)Stage::Count];
+LatencyHistogram frameReads;
+LatencyHistogram frameBytes;
+
+// Events claim a slot with one fetch_add; once full, later events only reach the histograms
+std::unique_ptr<TraceEvent[]> traceEvents;
+std::unique_ptr<FrameEvent[]> frameEvents;
+std::atomic<size_t> traceCount{ 0 };
+std::atomic<size_t> frameCount{ 0 };
+uint64_t traceOrigin = 0;
+
+std::atomic<uint32_t> nextThread{ 0 };
+
+uint32_t ThreadIndex() {
+    thread_local uint32_t index = ++nextThread;
+    return index;
+}
+
+int HighestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return (int)index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+size_t BucketOf(uint64_t value) {
+    if (value < 4) return (size_t)value;
+    int bit = HighestBit(value);
+    return (size_t)((bit - 1) * 4 + ((value >> (bit - 2)) & 3));
+}
+
+uint64_t BucketMidpoint(size_t bucket) {
+    if (bucket < 4) return bucket;
+    int bit = (int)(bucket / 4) + 1;
+    uint64_t width = 1ull << (bit - 2);
+    return (4 + bucket % 4) * width + width / 2;
+}
+
+}
+
+std::atomic<bool> Profiler::enabled{ false };
+
+void LatencyHistogram::Record(uint64_t value) {
+    buckets[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t seen = max.load(std::memory_order_relaxed);
+    while (value > seen && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Reset() {
+    for (std::atomic<uint32_t>& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+    uint64_t samples = Count();
+    if (!samples) return 0;
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (samples - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) return (std::min)(BucketMidpoint(i), Max());
+    }
+    return Max();
+}
+
+uint64_t Profiler::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* Profiler::StageName(Stage stage) {
+    switch (stage) {
+    case Stage::Scan: return "scan";
+    case Stage::ActorRead: return "actor_read";
+    case Stage::Classify: return "classify";
+    case Stage::Projection: return "projection";
+    case Stage::DrawList: return "draw_list";
+    case Stage::Present: return "present";
+    default: return "unknown";
+    }
+}
+
+void Profiler::SetEnabled(bool on) {
+    if (on == Enabled()) return;
+
+    if (on) {
+        if (!traceEvents) traceEvents.reset(new TraceEvent[kTraceCapacity]);
+        if (!frameEvents) frameEvents.reset(new FrameEvent[kFrameCapacity]);
+        for (LatencyHistogram& histogram : stageLatency) histogram.Reset();
+        frameReads.Reset();
+        frameBytes.Reset();
+        traceCount = 0;
+        frameCount = 0;
+        traceOrigin = Now();
+    }
+    enabled.store(on);
+}
+
+void Profiler::Record(Stage stage, uint64_t start, uint64_t end) {
+    uint64_t duration = end - start;
+    stageLatency[(size_t)stage].Record(duration);
+
+    size_t slot = traceCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot < kTraceCapacity) traceEvents[slot] = { start, duration, ThreadIndex(), stage };
+}
+
+void Profiler::RecordFrame(uint64_t reads, uint64_t bytes) {
+    if (!Enabled()) return;
+
+    frameReads.Record(reads);
+    frameBytes.Record(bytes);
+
+    size_t slot = frameCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot < kFrameCapacity) frameEvents[slot] = { Now(), reads, bytes };
+}
+
+const LatencyHistogram& Profiler::StageLatency(Stage stage) {
+    return stageLatency[(size_t)stage];
+}
+
+const LatencyHistogram& Profiler::FrameReads() {
+    return frameReads;
+}
+
+const LatencyHistogram& Profiler::FrameBytes() {
+    return frameBytes;
+}
+
+bool Profiler::WriteTrace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    const char* separator = "";
+
+    size_t events = traceEvents ? (std::min)(traceCount.load(), kTraceCapacity) : 0;
+    for (size_t i = 0; i < events; i++) {
+        const TraceEvent& event = traceEvents[i];
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            separator, StageName(event.stage), event.thread,
+            (event.start - traceOrigin) / 1e3, event.duration / 1e3);
+        separator = ",\n";
+    }
+
+    // Per-sample remote traffic as counter tracks
+    size_t frames = frameEvents ? (std::min)(frameCount.load(), kFrameCapacity) : 0;
+    for (size_t i = 0; i < frames; i++) {
+        const FrameEvent& event = frameEvents[i];
+        fprintf(file, "%s{\"name\":\"remote_reads\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"calls\":%llu,\"bytes\":%llu}}",
+            separator, (event.time - traceOrigin) / 1e3,
+            (unsigned long long)event.reads, (unsigned long long)event.bytes);
+        separator = ",\n";
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(file) == 0;
+}
+
+bool Profiler::WriteCsv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    auto row = [file](const char* name, const char* unit, const LatencyHistogram& histogram, double scale) {
+        uint64_t samples = histogram.Count();
+        fprintf(file, "%s,%s,%llu,%.3f,%.3f,%.3f,%.3f\n", name, unit, (unsigned long long)samples,
+            samples ? histogram.Total() / (double)samples / scale : 0.0,
+            histogram.Percentile(50) / scale, histogram.Percentile(99) / scale, histogram.Max() / scale);
+    };
+
+    fprintf(file, "name,unit,count,mean,p50,p99,max\n");
+    for (size_t stage = 0; stage < (size_t)Stage::Count; stage++)
+        row(StageName((Stage)stage), "us", stageLatency[stage], 1e3);
+    row("reads_per_frame", "calls", frameReads, 1.0);
+    row("bytes_per_frame", "bytes", frameBytes, 1.0);
+
+    return fclose(file) == 0;
+}
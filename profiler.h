@@ -0,0 +1,84 @@
+/*
+* File: profiler.h
+* Hot-path instrumentation for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+enum class Stage : uint8_t {
+    Scan,
+    ActorRead,
+    Classify,
+    Projection,
+    DrawList,
+    Present,
+    Count,
+};
+
+// Log-bucketed histogram, four buckets per power of two, so percentiles are
+// within ~12%. Recording is a few relaxed atomic adds.
+class LatencyHistogram {
+public:
+    void Record(uint64_t value);
+    void Reset();
+
+    uint64_t Percentile(double percentile) const;
+    uint64_t Count() const { return count.load(std::memory_order_relaxed); }
+    uint64_t Total() const { return total.load(std::memory_order_relaxed); }
+    uint64_t Max() const { return max.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kBuckets = 256;
+
+    std::atomic<uint32_t> buckets[kBuckets] = {};
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> total{ 0 };
+    std::atomic<uint64_t> max{ 0 };
+};
+
+// Process-wide stage timings and per-frame remote traffic. Everything is a
+// no-op apart from one relaxed load while disabled.
+class Profiler {
+public:
+    static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+    // Enabling starts a fresh recording; disable before exporting it. Neither
+    // may overlap Record/RecordFrame on another thread, so pause those first.
+    static void SetEnabled(bool on);
+
+    static uint64_t Now();  // steady clock, nanoseconds
+    static const char* StageName(Stage stage);
+
+    static void Record(Stage stage, uint64_t start, uint64_t end);
+    // Remote read calls and bytes one memory sample cost.
+    static void RecordFrame(uint64_t reads, uint64_t bytes);
+
+    static const LatencyHistogram& StageLatency(Stage stage);
+    static const LatencyHistogram& FrameReads();
+    static const LatencyHistogram& FrameBytes();
+
+    // chrome://tracing / Perfetto JSON with one slice per timed scope
+    static bool WriteTrace(const char* path);
+    // Summary table: count, mean, p50, p99 and max per stage and per-frame counter
+    static bool WriteCsv(const char* path);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage) : stage(stage), start(Profiler::Enabled() ? Profiler::Now() : 0) {}
+    ~ScopedTimer() {
+        if (start) Profiler::Record(stage, start, Profiler::Now());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage stage;
+    uint64_t start;
+};
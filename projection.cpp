@@ -0,0 +1,171 @@
+/*
+* File: projection.cpp
+* Batched SIMD world-to-screen projection for Winter Survival ESP
+*/
+
+#include "projection.h"
+#include <cmath>
+#include <immintrin.h>
+#include <xmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PROJECTION_TARGET_AVX __attribute__((target("avx")))
+#else
+#define PROJECTION_TARGET_AVX
+#endif
+
+static bool HasAVX() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return avx && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+static const bool kUseAVX = HasAVX();
+
+Matrix4 Multiply(const Matrix4& a, const Matrix4& b) {
+    Matrix4 result;
+    for (int row = 0; row < 4; row++) {
+        for (int column = 0; column < 4; column++) {
+            result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] +
+                a.m[row][2] * b.m[2][column] + a.m[row][3] * b.m[3][column];
+        }
+    }
+    return result;
+}
+
+// Scalar version for the tail of a batch, with the same culling rules
+static size_t ProjectScalar(const Matrix4& m, const ProjectionParams& params,
+    const float* xs, const float* ys, const float* zs, size_t first, size_t count,
+    float* screenX, float* screenY, uint32_t* indices, size_t written) {
+    float halfWidth = params.viewportWidth * 0.5f;
+    float halfHeight = params.viewportHeight * 0.5f;
+
+    for (size_t i = first; i < count; i++) {
+        float x = xs[i], y = ys[i], z = zs[i];
+        float cx = x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0] + m.m[3][0];
+        float cy = x * m.m[0][1] + y * m.m[1][1] + z * m.m[2][1] + m.m[3][1];
+        float cw = x * m.m[0][3] + y * m.m[1][3] + z * m.m[2][3] + m.m[3][3];
+
+        float limit = cw * params.guardBand;
+        // Written as the SIMD paths' ordered compares, so NaN coordinates are rejected too
+        if (!(cw >= params.nearW && fabsf(cx) <= limit && fabsf(cy) <= limit)) continue;
+
+        float inverse = 1.0f / cw;
+        screenX[written] = (cx * inverse + 1.0f) * halfWidth;
+        screenY[written] = (1.0f - cy * inverse) * halfHeight;
+        indices[written] = (uint32_t)i;
+        written++;
+    }
+    return written;
+}
+
+static size_t ProjectSSE(const Matrix4& m, const ProjectionParams& params,
+    const float* xs, const float* ys, const float* zs, size_t count,
+    float* screenX, float* screenY, uint32_t* indices) {
+    const __m128 m00 = _mm_set1_ps(m.m[0][0]), m10 = _mm_set1_ps(m.m[1][0]), m20 = _mm_set1_ps(m.m[2][0]), m30 = _mm_set1_ps(m.m[3][0]);
+    const __m128 m01 = _mm_set1_ps(m.m[0][1]), m11 = _mm_set1_ps(m.m[1][1]), m21 = _mm_set1_ps(m.m[2][1]), m31 = _mm_set1_ps(m.m[3][1]);
+    const __m128 m03 = _mm_set1_ps(m.m[0][3]), m13 = _mm_set1_ps(m.m[1][3]), m23 = _mm_set1_ps(m.m[2][3]), m33 = _mm_set1_ps(m.m[3][3]);
+    const __m128 nearW = _mm_set1_ps(params.nearW);
+    const __m128 guard = _mm_set1_ps(params.guardBand);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 halfWidth = _mm_set1_ps(params.viewportWidth * 0.5f);
+    const __m128 halfHeight = _mm_set1_ps(params.viewportHeight * 0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i), z = _mm_loadu_ps(zs + i);
+        __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_add_ps(_mm_mul_ps(z, m20), m30));
+        __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_add_ps(_mm_mul_ps(z, m21), m31));
+        __m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m03), _mm_mul_ps(y, m13)), _mm_add_ps(_mm_mul_ps(z, m23), m33));
+
+        // |cx| <= w * guard, |cy| <= w * guard, w >= nearW
+        __m128 limit = _mm_mul_ps(cw, guard);
+        __m128 visible = _mm_and_ps(_mm_cmpge_ps(cw, nearW),
+            _mm_and_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, cx), limit), _mm_cmple_ps(_mm_andnot_ps(signMask, cy), limit)));
+        int mask = _mm_movemask_ps(visible);
+        if (!mask) continue;
+
+        __m128 inverse = _mm_div_ps(one, cw);
+        __m128 sx = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cx, inverse), one), halfWidth);
+        __m128 sy = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(cy, inverse)), halfHeight);
+
+        alignas(16) float lanesX[4], lanesY[4];
+        _mm_store_ps(lanesX, sx);
+        _mm_store_ps(lanesY, sy);
+        for (int lane = 0; lane < 4; lane++) {
+            // Branch-free compaction: always write, only advance on visible lanes
+            screenX[written] = lanesX[lane];
+            screenY[written] = lanesY[lane];
+            indices[written] = (uint32_t)(i + lane);
+            written += (mask >> lane) & 1;
+        }
+    }
+
+    return ProjectScalar(m, params, xs, ys, zs, i, count, screenX, screenY, indices, written);
+}
+
+PROJECTION_TARGET_AVX
+static size_t ProjectAVX(const Matrix4& m, const ProjectionParams& params,
+    const float* xs, const float* ys, const float* zs, size_t count,
+    float* screenX, float* screenY, uint32_t* indices) {
+    const __m256 m00 = _mm256_set1_ps(m.m[0][0]), m10 = _mm256_set1_ps(m.m[1][0]), m20 = _mm256_set1_ps(m.m[2][0]), m30 = _mm256_set1_ps(m.m[3][0]);
+    const __m256 m01 = _mm256_set1_ps(m.m[0][1]), m11 = _mm256_set1_ps(m.m[1][1]), m21 = _mm256_set1_ps(m.m[2][1]), m31 = _mm256_set1_ps(m.m[3][1]);
+    const __m256 m03 = _mm256_set1_ps(m.m[0][3]), m13 = _mm256_set1_ps(m.m[1][3]), m23 = _mm256_set1_ps(m.m[2][3]), m33 = _mm256_set1_ps(m.m[3][3]);
+    const __m256 nearW = _mm256_set1_ps(params.nearW);
+    const __m256 guard = _mm256_set1_ps(params.guardBand);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 halfWidth = _mm256_set1_ps(params.viewportWidth * 0.5f);
+    const __m256 halfHeight = _mm256_set1_ps(params.viewportHeight * 0.5f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i), z = _mm256_loadu_ps(zs + i);
+        __m256 cx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m00), _mm256_mul_ps(y, m10)), _mm256_add_ps(_mm256_mul_ps(z, m20), m30));
+        __m256 cy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m01), _mm256_mul_ps(y, m11)), _mm256_add_ps(_mm256_mul_ps(z, m21), m31));
+        __m256 cw = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m03), _mm256_mul_ps(y, m13)), _mm256_add_ps(_mm256_mul_ps(z, m23), m33));
+
+        __m256 limit = _mm256_mul_ps(cw, guard);
+        __m256 visible = _mm256_and_ps(_mm256_cmp_ps(cw, nearW, _CMP_GE_OQ),
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, cx), limit, _CMP_LE_OQ),
+                _mm256_cmp_ps(_mm256_andnot_ps(signMask, cy), limit, _CMP_LE_OQ)));
+        int mask = _mm256_movemask_ps(visible);
+        if (!mask) continue;
+
+        __m256 inverse = _mm256_div_ps(one, cw);
+        __m256 sx = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(cx, inverse), one), halfWidth);
+        __m256 sy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(cy, inverse)), halfHeight);
+
+        alignas(32) float lanesX[8], lanesY[8];
+        _mm256_store_ps(lanesX, sx);
+        _mm256_store_ps(lanesY, sy);
+        for (int lane = 0; lane < 8; lane++) {
+            screenX[written] = lanesX[lane];
+            screenY[written] = lanesY[lane];
+            indices[written] = (uint32_t)(i + lane);
+            written += (mask >> lane) & 1;
+        }
+    }
+
+    return ProjectScalar(m, params, xs, ys, zs, i, count, screenX, screenY, indices, written);
+}
+
+size_t ProjectPoints(const Matrix4& viewProj, const ProjectionParams& params,
+    const float* xs, const float* ys, const float* zs, size_t count,
+    float* screenX, float* screenY, uint32_t* indices) {
+    return kUseAVX ? ProjectAVX(viewProj, params, xs, ys, zs, count, screenX, screenY, indices)
+        : ProjectSSE(viewProj, params, xs, ys, zs, count, screenX, screenY, indices);
+}
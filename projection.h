@@ -0,0 +1,27 @@
+/*
+* File: projection.h
+* Batched SIMD world-to-screen projection for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "types.h"
+
+// Row-vector product a * b, the same convention as XMMatrixMultiply.
+Matrix4 Multiply(const Matrix4& a, const Matrix4& b);
+
+struct ProjectionParams {
+    float viewportWidth;
+    float viewportHeight;
+    float nearW = 0.1f;     // points with a smaller clip w are behind the camera
+    float guardBand = 1.0f;  // 1 culls exactly at the screen edge, larger keeps points just outside
+};
+
+// Projects count points given as separate x/y/z arrays through viewProj,
+// drops the ones behind the camera or outside the frustum and writes the rest
+// packed to screenX/screenY, with indices[k] naming the source point. Uses AVX
+// when available, SSE otherwise. Returns the number of points written.
+size_t ProjectPoints(const Matrix4& viewProj, const ProjectionParams& params,
+    const float* xs, const float* ys, const float* zs, size_t count,
+    float* screenX, float* screenY, uint32_t* indices);
@@ -0,0 +1,69 @@
+/*
+* File: readerthread.cpp
+* Background memory sampling thread for Winter Survival ESP
+*/
+
+#include "readerthread.h"
+#include "logger.h"
+#include "profiler.h"
+#include <chrono>
+#include <cstdio>
+
+ReaderThread::~ReaderThread() {
+    Stop();
+}
+
+void ReaderThread::Start(MemoryReader& memory, double sampleRate) {
+    Stop();
+    running = true;
+    thread = std::thread(&ReaderThread::Run, this, std::ref(memory), sampleRate);
+}
+
+void ReaderThread::Stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+}
+
+void ReaderThread::RequestCapture(const char* path) {
+    if (captureRequested) return;
+    snprintf(capturePath, sizeof(capturePath), "%s", path);
+    captureRequested = true;
+}
+
+void ReaderThread::Run(MemoryReader& memory, double sampleRate) {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / sampleRate));
+    auto next = Clock::now();
+
+    while (running) {
+        if (captureRequested) {
+            if (!memory.CaptureSnapshot(capturePath))
+                LOG_WARNING("Failed to capture snapshot");
+            captureRequested = false;
+            next = Clock::now();
+        }
+
+        MemoryBackend* backend = memory.Backend();
+        uint64_t reads = backend->ReadCalls();
+        uint64_t bytes = backend->ReadBytes();
+
+        WorldSnapshot& snapshot = snapshots.Back();
+        memory.GetObjects(snapshot.entities);
+        snapshot.index.Build(snapshot.entities);
+        snapshot.view = memory.GetViewMatrix();
+        snapshot.projection = memory.GetProjectionMatrix();
+        snapshot.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count();
+        snapshot.sequence = ++samples;
+        if (recorder) recorder->Record(snapshot);
+        snapshots.Publish();
+
+        Profiler::RecordFrame(backend->ReadCalls() - reads, backend->ReadBytes() - bytes);
+
+        // Fixed-rate schedule; if a sample overran, start the next one right away
+        next += period;
+        auto now = Clock::now();
+        if (next < now) next = now;
+        else std::this_thread::sleep_until(next);
+    }
+}
@@ -0,0 +1,49 @@
+/*
+* File: readerthread.h
+* Background memory sampling thread for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include "memory.h"
+#include "recording.h"
+#include "triplebuffer.h"
+#include "world.h"
+
+// Samples MemoryReader on its own thread at a fixed rate and publishes each
+// result through a triple buffer, so slow remote reads never stall a frame.
+class ReaderThread {
+public:
+    ~ReaderThread();
+
+    void Start(MemoryReader& memory, double sampleRate);
+    void Stop();
+
+    // Every published snapshot is also handed to recorder; set before Start.
+    void SetRecorder(SnapshotRecorder* recorder) { this->recorder = recorder; }
+
+    // Newest complete snapshot; never blocks. Only call from one (the render) thread.
+    const WorldSnapshot& Latest() {
+        snapshots.Update();
+        return snapshots.Front();
+    }
+
+    uint64_t Samples() const { return samples; }
+
+    // Dumps the process to path on the reader thread before its next sample,
+    // so the render loop keeps drawing and the backend has one user at a time.
+    // Ignored while an earlier capture is still pending.
+    void RequestCapture(const char* path);
+
+private:
+    TripleBuffer<WorldSnapshot> snapshots;
+    SnapshotRecorder* recorder = nullptr;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<uint64_t> samples{ 0 };
+    std::atomic<bool> captureRequested{ false };
+    char capturePath[260] = {};
+
+    void Run(MemoryReader& memory, double sampleRate);
+};
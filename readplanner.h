@@ -0,0 +1,35 @@
+/*
+* File: readplanner.h
+* Batched scatter-gather remote reads for Winter Survival ESP
+*/
+
+#pragma once
+#include "backend.h"
+#include <vector>
+
+// Collects the reads of one dependency level (e.g. every actor's root component)
+// and hands them to the backend as a single batch.
+class ReadPlanner {
+public:
+    void Reset() { requests.clear(); }
+
+    void Add(uintptr_t address, void* buffer, size_t size) {
+        requests.push_back({ address, buffer, size, false });
+    }
+
+    template<typename T>
+    void Add(uintptr_t address, T* value) {
+        Add(address, value, sizeof(T));
+    }
+
+    // Returns the number of requests that were read completely.
+    size_t Execute(MemoryBackend& backend) {
+        return backend.ReadBatch(requests.data(), requests.size());
+    }
+
+    size_t Size() const { return requests.size(); }
+    const ReadRequest& operator[](size_t index) const { return requests[index]; }
+
+private:
+    std::vector<ReadRequest> requests;
+};
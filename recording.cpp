@@ -0,0 +1,358 @@
+/*
+* File: recording.cpp
+* Compact world snapshot recording and replay for Winter Survival ESP
+*/
+
+#include "recording.h"
+#include "lzblock.h"
+#include <cmath>
+#include <cstring>
+
+enum FrameFlags : uint8_t {
+    kFrameKey = 1 << 0,
+    kFrameView = 1 << 1,        // view matrix follows
+    kFrameProjection = 1 << 2,  // projection matrix follows
+};
+
+static void PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static void PutSigned(std::vector<uint8_t>& out, int64_t value) {
+    PutVarint(out, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static void PutBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    out.insert(out.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+}
+
+// Bounds-checked reader over one decoded block
+struct ByteReader {
+    const uint8_t* at;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint64_t Varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (at >= end) break;
+            uint8_t byte = *at++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t Signed() {
+        uint64_t value = Varint();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    void Bytes(void* data, size_t size) {
+        if ((size_t)(end - at) < size) {
+            ok = false;
+            memset(data, 0, size);
+            return;
+        }
+        memcpy(data, at, size);
+        at += size;
+    }
+};
+
+static int32_t Quantize(float value, float step) {
+    // Garbage reads (NaN, absurd coordinates) are pinned rather than overflowing
+    float scaled = value / step;
+    if (!(scaled > -1e9f && scaled < 1e9f)) return 0;
+    return (int32_t)lroundf(scaled);
+}
+
+void SnapshotCodec::MatchPrevious(const std::vector<uint32_t>& current) {
+    size_t count = current.size();
+    matched.resize(count);
+    for (size_t i = 0; i < count; i++) matched[i] = i < ids.size() && ids[i] == current[i];
+
+    // Slots past the previous frame compare against zero
+    ids.assign(current.begin(), current.end());
+    qx.resize(count, 0);
+    qy.resize(count, 0);
+    qz.resize(count, 0);
+    times.resize(count, 0);
+    categories.resize(count, ActorCategory::Unknown);
+    extents.resize(count, Vec3{ 0.0f, 0.0f, 0.0f });
+}
+
+void SnapshotCodec::Encode(const WorldSnapshot& snapshot, std::vector<uint8_t>& out) {
+    const EntityStore& entities = snapshot.entities;
+    size_t count = entities.Size();
+    out.clear();
+
+    bool key = frames++ % kKeyInterval == 0;
+    if (key) {
+        ids.clear();
+        timestamp = 0;
+    }
+    uint8_t flags = key ? kFrameKey : 0;
+    if (key || memcmp(&view, &snapshot.view, sizeof(view)) != 0) flags |= kFrameView;
+    if (key || memcmp(&projection, &snapshot.projection, sizeof(projection)) != 0) flags |= kFrameProjection;
+
+    out.push_back(flags);
+    PutSigned(out, (int64_t)(snapshot.timestamp - timestamp));
+    if (flags & kFrameView) PutBytes(out, &snapshot.view, sizeof(snapshot.view));
+    if (flags & kFrameProjection) PutBytes(out, &snapshot.projection, sizeof(snapshot.projection));
+    PutVarint(out, count);
+
+    // Column by column, each against the same slot of the previous frame
+    for (size_t i = 0; i < count; i++)
+        PutSigned(out, (int64_t)entities.ids[i] - (int64_t)(i < ids.size() ? ids[i] : 0));
+    MatchPrevious(entities.ids);
+
+    // Category and extents only change with the actor, so only new ones carry them
+    for (size_t i = 0; i < count; i++) {
+        if (matched[i]) continue;
+        out.push_back((uint8_t)entities.categories[i]);
+        PutBytes(out, &entities.extents[i], sizeof(Vec3));
+    }
+
+    PutBytes(out, entities.flags.data(), count);
+
+    const std::vector<float>* columns[3] = { &entities.x, &entities.y, &entities.z };
+    std::vector<int32_t>* previous[3] = { &qx, &qy, &qz };
+    for (int axis = 0; axis < 3; axis++) {
+        std::vector<int32_t>& q = *previous[axis];
+        for (size_t i = 0; i < count; i++) {
+            int32_t value = Quantize((*columns[axis])[i], step);
+            PutSigned(out, (int64_t)value - (matched[i] ? q[i] : 0));
+            q[i] = value;
+        }
+    }
+
+    uint64_t frameMicros = snapshot.timestamp / 1000;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t micros = entities.sampleTimes[i] / 1000;
+        PutSigned(out, (int64_t)(micros - (matched[i] ? times[i] : frameMicros)));
+        times[i] = micros;
+    }
+
+    view = snapshot.view;
+    projection = snapshot.projection;
+    timestamp = snapshot.timestamp;
+}
+
+bool SnapshotCodec::Decode(const uint8_t* data, size_t size, WorldSnapshot& snapshot) {
+    ByteReader in = { data, data + size };
+    EntityStore& entities = snapshot.entities;
+
+    uint8_t flags = 0;
+    in.Bytes(&flags, 1);
+    if (flags & kFrameKey) {
+        ids.clear();
+        timestamp = 0;
+    }
+    timestamp += (uint64_t)in.Signed();
+    if (flags & kFrameView) in.Bytes(&view, sizeof(view));
+    if (flags & kFrameProjection) in.Bytes(&projection, sizeof(projection));
+
+    uint64_t count = in.Varint();
+    if (!in.ok || count > size) return false;  // every entity takes at least a byte
+    entities.Resize((size_t)count);
+
+    for (size_t i = 0; i < count; i++)
+        entities.ids[i] = (uint32_t)(in.Signed() + (int64_t)(i < ids.size() ? ids[i] : 0));
+    MatchPrevious(entities.ids);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!matched[i]) {
+            uint8_t category = 0;
+            in.Bytes(&category, 1);
+            categories[i] = (ActorCategory)category;
+            in.Bytes(&extents[i], sizeof(Vec3));
+        }
+        entities.categories[i] = categories[i];
+        entities.extents[i] = extents[i];
+    }
+
+    in.Bytes(entities.flags.data(), (size_t)count);
+
+    std::vector<float>* columns[3] = { &entities.x, &entities.y, &entities.z };
+    std::vector<int32_t>* previous[3] = { &qx, &qy, &qz };
+    for (int axis = 0; axis < 3; axis++) {
+        std::vector<int32_t>& q = *previous[axis];
+        for (size_t i = 0; i < count; i++) {
+            q[i] = (int32_t)(in.Signed() + (matched[i] ? q[i] : 0));
+            (*columns[axis])[i] = q[i] * step;
+        }
+    }
+
+    uint64_t frameMicros = timestamp / 1000;
+    for (size_t i = 0; i < count; i++) {
+        times[i] = (uint64_t)in.Signed() + (matched[i] ? times[i] : frameMicros);
+        entities.sampleTimes[i] = times[i] * 1000;
+    }
+
+    snapshot.view = view;
+    snapshot.projection = projection;
+    snapshot.timestamp = timestamp;
+    return in.ok;
+}
+
+SnapshotRecorder::~SnapshotRecorder() {
+    Stop();
+}
+
+bool SnapshotRecorder::Start(const char* path, float step) {
+    Stop();
+    file = fopen(path, "wb");
+    if (!file) return false;
+
+    RecordingHeader header = { { 'W', 'S', 'S', 'R' }, SnapshotCodec::kVersion, step, SnapshotCodec::kKeyInterval };
+    fwrite(&header, sizeof(header), 1, file);
+
+    codec = SnapshotCodec(step);
+    produced = consumed = 0;
+    stopping = false;
+    frames = dropped = rawBytes = 0;
+    fileBytes = sizeof(header);
+    writer = std::thread(&SnapshotRecorder::WriterLoop, this);
+    return true;
+}
+
+void SnapshotRecorder::Stop() {
+    if (!file) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    ready.notify_one();
+    writer.join();
+    fclose(file);
+    file = nullptr;
+}
+
+void SnapshotRecorder::Record(const WorldSnapshot& snapshot) {
+    if (!file) return;
+
+    size_t slot;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (produced - consumed >= kQueueDepth) {
+            dropped++;
+            return;
+        }
+        slot = produced % kQueueDepth;
+    }
+
+    // The writer never touches a slot before it is produced; copies reuse the slot's storage
+    WorldSnapshot& copy = slots[slot];
+    copy.entities = snapshot.entities;
+    copy.view = snapshot.view;
+    copy.projection = snapshot.projection;
+    copy.timestamp = snapshot.timestamp;
+    copy.sequence = snapshot.sequence;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        produced++;
+    }
+    ready.notify_one();
+}
+
+void SnapshotRecorder::WriterLoop() {
+    std::vector<uint8_t> raw, packed;
+
+    while (true) {
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ready.wait(guard, [this] { return stopping || consumed < produced; });
+            if (consumed == produced) return;  // stopping and drained
+            slot = consumed % kQueueDepth;
+        }
+
+        codec.Encode(slots[slot], raw);
+        packed.resize(LzBound(raw.size()));
+        uint32_t sizes[2] = { (uint32_t)raw.size(), (uint32_t)LzCompress(raw.data(), raw.size(), packed.data()) };
+        const uint8_t* body = packed.data();
+        if (sizes[1] >= sizes[0]) {
+            sizes[1] = sizes[0];
+            body = raw.data();
+        }
+        fwrite(sizes, sizeof(sizes), 1, file);
+        fwrite(body, 1, sizes[1], file);
+
+        frames++;
+        rawBytes += sizes[0];
+        fileBytes += sizeof(sizes) + sizes[1];
+
+        std::lock_guard<std::mutex> guard(lock);
+        consumed++;
+    }
+}
+
+SnapshotPlayer::~SnapshotPlayer() {
+    Close();
+}
+
+bool SnapshotPlayer::Open(const char* path) {
+    Close();
+    file = fopen(path, "rb");
+    if (!file) return false;
+
+    RecordingHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, "WSSR", 4) != 0 ||
+        header.version != SnapshotCodec::kVersion || !(header.step > 0.0f)) {
+        Close();
+        return false;
+    }
+
+    codec = SnapshotCodec(header.step);
+    dataStart = ftell(file);
+    return true;
+}
+
+void SnapshotPlayer::Close() {
+    if (file) fclose(file);
+    file = nullptr;
+}
+
+void SnapshotPlayer::Rewind() {
+    // The first block is a key frame, so the codec needs no reset
+    if (file) fseek(file, dataStart, SEEK_SET);
+}
+
+bool SnapshotPlayer::Next(WorldSnapshot& snapshot) {
+    // A damaged block breaks the delta chain, so everything up to the next key
+    // frame is skipped; a damaged size prefix loses the framing and ends the replay
+    bool resync = false;
+    while (true) {
+        uint32_t sizes[2];
+        if (!file || fread(sizes, sizeof(sizes), 1, file) != 1) return false;
+        if (sizes[0] > (1u << 30) || sizes[1] > LzBound(sizes[0])) return false;
+
+        packed.resize(sizes[1]);
+        if (fread(packed.data(), 1, sizes[1], file) != sizes[1]) return false;
+
+        const uint8_t* body = packed.data();
+        if (sizes[1] != sizes[0]) {
+            raw.resize(sizes[0]);
+            if (!LzDecompress(packed.data(), sizes[1], raw.data(), sizes[0])) {
+                resync = true;
+                continue;
+            }
+            body = raw.data();
+        }
+
+        if (resync && !(sizes[0] && (body[0] & kFrameKey))) continue;
+        if (!codec.Decode(body, sizes[0], snapshot)) {
+            resync = true;
+            continue;
+        }
+        snapshot.index.Build(snapshot.entities);
+        snapshot.sequence = ++sequence;
+        return true;
+    }
+}
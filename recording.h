@@ -0,0 +1,128 @@
+/*
+* File: recording.h
+* Compact world snapshot recording and replay for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "world.h"
+
+// File layout: a RecordingHeader, then one block per frame of
+// { uint32 rawSize, uint32 packedSize, packedSize bytes }, LZ-compressed
+// unless packedSize equals rawSize. Each frame is varint-coded against the
+// previous one: entities are compared with the same slot of the last frame
+// (tracker order is stable, so most deltas are zero), positions are quantized
+// to a grid of step units, and a key frame every kKeyInterval frames is coded
+// against nothing, so SnapshotPlayer skips from a damaged block to the next
+// key frame and loses at most that many frames.
+struct RecordingHeader {
+    char magic[4];     // "WSSR"
+    uint32_t version;
+    float step;        // position quantum
+    uint32_t keyInterval;
+};
+
+class SnapshotCodec {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kKeyInterval = 300;
+    static constexpr float kDefaultStep = 0.5f;
+
+    explicit SnapshotCodec(float step = kDefaultStep) : step(step) {}
+
+    float Step() const { return step; }
+    // Next frame is a key frame.
+    void Reset() { frames = 0; }
+
+    void Encode(const WorldSnapshot& snapshot, std::vector<uint8_t>& out);
+    // Fills everything but the spatial index and the sequence number.
+    bool Decode(const uint8_t* data, size_t size, WorldSnapshot& snapshot);
+
+private:
+    float step;
+    uint64_t frames = 0;
+
+    // The previous frame as coded, quantized
+    std::vector<uint32_t> ids;
+    std::vector<int32_t> qx, qy, qz;
+    std::vector<uint64_t> times;  // sample times in microseconds
+    std::vector<ActorCategory> categories;
+    std::vector<Vec3> extents;
+    std::vector<uint8_t> matched;  // per slot: same entity as in the previous frame
+    Matrix4 view = {};
+    Matrix4 projection = {};
+    uint64_t timestamp = 0;
+
+    // Marks the slots that hold the same entity as last frame and makes
+    // current the reference ids, with the other columns sized to match.
+    void MatchPrevious(const std::vector<uint32_t>& current);
+};
+
+// Streams snapshots to a file. Record copies the snapshot into one of a few
+// preallocated slots and returns; a writer thread encodes, compresses and
+// writes. When every slot is still queued the frame is dropped and counted,
+// so the caller never waits on the disk.
+class SnapshotRecorder {
+public:
+    static constexpr size_t kQueueDepth = 8;
+
+    ~SnapshotRecorder();
+
+    bool Start(const char* path, float step = SnapshotCodec::kDefaultStep);
+    void Stop();
+    bool Recording() const { return file != nullptr; }
+
+    void Record(const WorldSnapshot& snapshot);
+
+    uint64_t Frames() const { return frames; }
+    uint64_t Dropped() const { return dropped; }
+    uint64_t RawBytes() const { return rawBytes; }
+    uint64_t FileBytes() const { return fileBytes; }
+
+private:
+    FILE* file = nullptr;
+    SnapshotCodec codec;
+    WorldSnapshot slots[kQueueDepth];
+    uint64_t produced = 0;  // slots handed to the writer
+    uint64_t consumed = 0;  // slots written out
+    bool stopping = false;
+    std::mutex lock;
+    std::condition_variable ready;
+    std::thread writer;
+
+    std::atomic<uint64_t> frames{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> rawBytes{ 0 };
+    std::atomic<uint64_t> fileBytes{ 0 };
+
+    void WriterLoop();
+};
+
+// Reads a recording back frame by frame, ready for Overlay::Render.
+class SnapshotPlayer {
+public:
+    ~SnapshotPlayer();
+
+    bool Open(const char* path);
+    void Close();
+    // Back to the first frame.
+    void Rewind();
+
+    // Decodes the next frame into snapshot, index included; false at the
+    // end of the file or where a damaged size prefix loses the framing.
+    bool Next(WorldSnapshot& snapshot);
+
+private:
+    FILE* file = nullptr;
+    SnapshotCodec codec;
+    long dataStart = 0;
+    uint64_t sequence = 0;
+    std::vector<uint8_t> packed;
+    std::vector<uint8_t> raw;
+};
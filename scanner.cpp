@@ -0,0 +1,350 @@
+/*
+* File: scanner.cpp
+* SIMD multi-signature scanner for Winter Survival ESP
+*/
+
+#include "scanner.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SCANNER_TARGET_AVX2 __attribute__((target("avx2,bmi")))
+#else
+#define SCANNER_TARGET_AVX2
+#endif
+
+static inline unsigned LowestBit(uint32_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(bits);
+#endif
+}
+
+static bool HasAVX2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return avx2 && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static const bool kUseAVX2 = HasAVX2();
+
+// How often a byte shows up in x64 code; opcodes, REX prefixes and padding
+// make poor anchors because nearly every position would become a candidate
+static int AnchorCost(uint8_t value) {
+    switch (value) {
+    case 0x00: case 0xFF: case 0xCC: case 0x90: return 4;
+    case 0x48: case 0x8B: case 0x89: case 0x4C: case 0x8D: return 3;
+    case 0x0F: case 0x24: case 0xE8: case 0x83: case 0xC0: return 2;
+    default: return 1;
+    }
+}
+
+bool Signature::Parse(const char* pattern, Signature& out) {
+    out.pattern = pattern;
+    out.bytes.clear();
+    out.mask.clear();
+
+    const char* p = pattern;
+    while (*p) {
+        if (*p == ' ') {
+            p++;
+            continue;
+        }
+        if (*p == '?') {
+            out.bytes.push_back(0);
+            out.mask.push_back(0);
+            p += p[1] == '?' ? 2 : 1;
+            continue;
+        }
+
+        auto hex = [](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+        int high = hex(p[0]);
+        int low = high < 0 ? -1 : hex(p[1]);
+        if (low < 0) return false;
+        out.bytes.push_back((uint8_t)(high << 4 | low));
+        out.mask.push_back(0xFF);
+        p += 2;
+    }
+
+    // Pick the two cheapest fixed bytes as SIMD anchors
+    bool haveFirst = false, haveSecond = false;
+    for (size_t i = 0; i < out.bytes.size(); i++) {
+        if (!out.mask[i]) continue;
+        int cost = AnchorCost(out.bytes[i]);
+        if (!haveFirst || cost < AnchorCost(out.bytes[out.anchor])) {
+            if (haveFirst) {
+                out.secondAnchor = out.anchor;
+                haveSecond = true;
+            }
+            out.anchor = i;
+            haveFirst = true;
+        }
+        else if (!haveSecond || cost < AnchorCost(out.bytes[out.secondAnchor])) {
+            out.secondAnchor = i;
+            haveSecond = true;
+        }
+    }
+    if (!haveFirst) return false;
+    if (!haveSecond) out.secondAnchor = out.anchor;
+    return true;
+}
+
+bool Signature::Matches(const uint8_t* data) const {
+    for (size_t i = 0; i < bytes.size(); i++) {
+        if ((data[i] & mask[i]) != bytes[i]) return false;
+    }
+    return true;
+}
+
+// Earliest match of signature in data[0, size), or kNotFound
+static size_t FindSSE2(const Signature& signature, const uint8_t* data, size_t size) {
+    size_t length = signature.bytes.size();
+    if (size < length) return SignatureScanner::kNotFound;
+    size_t limit = size - length + 1;
+
+    const __m128i first = _mm_set1_epi8((char)signature.bytes[signature.anchor]);
+    const __m128i second = _mm_set1_epi8((char)signature.bytes[signature.secondAnchor]);
+    const uint8_t* a = data + signature.anchor;
+    const uint8_t* b = data + signature.secondAnchor;
+
+    size_t i = 0;
+    for (; i + 16 <= limit; i += 16) {
+        __m128i hitA = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)), first);
+        __m128i hitB = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(b + i)), second);
+        uint32_t bits = (uint32_t)_mm_movemask_epi8(_mm_and_si128(hitA, hitB));
+        while (bits) {
+            size_t candidate = i + LowestBit(bits);
+            if (signature.Matches(data + candidate)) return candidate;
+            bits &= bits - 1;
+        }
+    }
+    for (; i < limit; i++) {
+        if (signature.Matches(data + i)) return i;
+    }
+    return SignatureScanner::kNotFound;
+}
+
+SCANNER_TARGET_AVX2
+static size_t FindAVX2(const Signature& signature, const uint8_t* data, size_t size) {
+    size_t length = signature.bytes.size();
+    if (size < length) return SignatureScanner::kNotFound;
+    size_t limit = size - length + 1;
+
+    const __m256i first = _mm256_set1_epi8((char)signature.bytes[signature.anchor]);
+    const __m256i second = _mm256_set1_epi8((char)signature.bytes[signature.secondAnchor]);
+    const uint8_t* a = data + signature.anchor;
+    const uint8_t* b = data + signature.secondAnchor;
+
+    size_t i = 0;
+    for (; i + 32 <= limit; i += 32) {
+        __m256i hitA = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i)), first);
+        __m256i hitB = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(b + i)), second);
+        uint32_t bits = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(hitA, hitB));
+        while (bits) {
+            size_t candidate = i + LowestBit(bits);
+            if (signature.Matches(data + candidate)) return candidate;
+            bits &= bits - 1;
+        }
+    }
+    for (; i < limit; i++) {
+        if (signature.Matches(data + i)) return i;
+    }
+    return SignatureScanner::kNotFound;
+}
+
+size_t SignatureScanner::Add(const char* pattern) {
+    Signature signature;
+    if (!Signature::Parse(pattern, signature)) return kNotFound;
+
+    if (signature.bytes.size() > maxLength) maxLength = signature.bytes.size();
+    signatures.push_back(signature);
+    matches.push_back(0);
+    remaining++;
+    return signatures.size() - 1;
+}
+
+void SignatureScanner::Reset() {
+    for (uintptr_t& match : matches) match = 0;
+    remaining = signatures.size();
+}
+
+void SignatureScanner::Scan(const uint8_t* data, size_t size, uintptr_t baseAddress) {
+    ScanBlock(data, size, baseAddress, matches.data(), remaining);
+}
+
+void SignatureScanner::ScanBlock(const uint8_t* data, size_t size, uintptr_t baseAddress,
+    uintptr_t* results, size_t& pending) const {
+    // Walk the block in L2-sized slices and try every pending signature on each
+    // slice while it is still cached, instead of one full pass per signature
+    const size_t kSlice = 64 * 1024;
+    for (size_t offset = 0; offset < size && pending; offset += kSlice) {
+        size_t sliceSize = size - offset;
+        // Extend by the longest pattern so matches straddling slices are seen
+        if (sliceSize > kSlice + maxLength - 1) sliceSize = kSlice + maxLength - 1;
+
+        for (size_t id = 0; id < signatures.size(); id++) {
+            if (results[id]) continue;
+
+            const Signature& signature = signatures[id];
+            size_t searchSize = sliceSize;
+            // Only starts inside this slice belong to it, later ones belong to the next
+            if (searchSize > kSlice + signature.bytes.size() - 1) searchSize = kSlice + signature.bytes.size() - 1;
+
+            size_t hit = kUseAVX2 ? FindAVX2(signature, data + offset, searchSize)
+                : FindSSE2(signature, data + offset, searchSize);
+            if (hit != kNotFound) {
+                results[id] = baseAddress + offset + hit;
+                pending--;
+            }
+        }
+    }
+}
+
+// Query's region at address, clipped to [address, end); false once past end
+static bool NextRegion(MemoryBackend& backend, uintptr_t address, uintptr_t end, MemoryRegion& region) {
+    if (address >= end || !backend.Query(address, region) || region.base >= end) return false;
+    if (region.base + region.size <= address) return false;
+    if (region.base < address) {
+        region.size -= address - region.base;
+        region.base = address;
+    }
+    if (region.size > end - region.base) region.size = end - region.base;
+    return true;
+}
+
+bool SignatureScanner::ScanModule(MemoryBackend& backend, uintptr_t start, size_t size) {
+    MemoryRegion region;
+    uintptr_t address = start;
+    uintptr_t end = start + size;
+    chunk.resize(kChunkSize + maxLength);
+
+    while (remaining && NextRegion(backend, address, end, region)) {
+        if (region.committed && (region.protect & kProtectExecute) && (region.protect & kProtectRead)) {
+            const uint8_t* view = backend.View(region.base, region.size);
+            if (view) {
+                Scan(view, region.size, region.base);
+            }
+            else {
+                // Carry the last maxLength - 1 bytes over so matches across
+                // chunk boundaries are still found
+                size_t carry = 0;
+                for (size_t offset = 0; offset < region.size && remaining; ) {
+                    size_t size = region.size - offset < kChunkSize ? region.size - offset : kChunkSize;
+                    if (!backend.Read(region.base + offset, chunk.data() + carry, size)) {
+                        carry = 0;
+                        offset += size;
+                        continue;
+                    }
+                    Scan(chunk.data(), carry + size, region.base + offset - carry);
+
+                    size_t keep = maxLength > 1 ? maxLength - 1 : 0;
+                    if (keep > carry + size) keep = carry + size;
+                    memmove(chunk.data(), chunk.data() + carry + size - keep, keep);
+                    carry = keep;
+                    offset += size;
+                }
+            }
+        }
+        address = region.base + region.size;
+    }
+
+    return remaining == 0;
+}
+
+bool SignatureScanner::ScanModuleParallel(MemoryBackend& backend, uintptr_t start, size_t size, WorkStealingPool& pool) {
+    struct Chunk {
+        uintptr_t address;
+        size_t size;
+    };
+
+    // Cut every executable region into chunks that overlap the next one by the
+    // longest pattern, so no match is lost at a boundary
+    std::vector<Chunk> chunks;
+    MemoryRegion region;
+    uintptr_t address = start;
+    uintptr_t end = start + size;
+    while (NextRegion(backend, address, end, region)) {
+        if (region.committed && (region.protect & kProtectExecute) && (region.protect & kProtectRead)) {
+            for (size_t offset = 0; offset < region.size; offset += kChunkSize) {
+                size_t size = region.size - offset;
+                if (size > kChunkSize + maxLength - 1) size = kChunkSize + maxLength - 1;
+                chunks.push_back({ region.base + offset, size });
+            }
+        }
+        address = region.base + region.size;
+    }
+
+    const uintptr_t kNone = (uintptr_t)-1;
+    size_t count = signatures.size();
+    std::unique_ptr<std::atomic<uintptr_t>[]> best(new std::atomic<uintptr_t>[count]);
+    for (size_t id = 0; id < count; id++) best[id] = matches[id] ? matches[id] : kNone;
+
+    std::vector<std::vector<uint8_t>> buffers(pool.Slots());
+
+    // Submitted highest first so each worker pops its lowest chunk next, which
+    // lets early matches cancel as much of the tail as possible
+    for (size_t i = chunks.size(); i-- > 0;) {
+        Chunk chunk = chunks[i];
+        pool.Submit([this, &backend, &best, &buffers, chunk, count, kNone](size_t slot) {
+            std::vector<uintptr_t> results(count, 0);
+            size_t pending = 0;
+            for (size_t id = 0; id < count; id++) {
+                if (best[id].load(std::memory_order_relaxed) < chunk.address) results[id] = best[id];
+                else pending++;
+            }
+            if (!pending) return;
+
+            const uint8_t* data = backend.View(chunk.address, chunk.size);
+            if (!data) {
+                std::vector<uint8_t>& buffer = buffers[slot];
+                buffer.resize(chunk.size);
+                if (!backend.Read(chunk.address, buffer.data(), chunk.size)) return;
+                data = buffer.data();
+            }
+
+            size_t before = pending;
+            ScanBlock(data, chunk.size, chunk.address, results.data(), pending);
+            if (pending == before) return;
+
+            for (size_t id = 0; id < count; id++) {
+                uintptr_t found = results[id];
+                if (!found || found < chunk.address) continue;
+                uintptr_t current = best[id].load();
+                while (found < current && !best[id].compare_exchange_weak(current, found)) {
+                }
+            }
+        });
+    }
+    pool.Wait();
+
+    remaining = 0;
+    for (size_t id = 0; id < count; id++) {
+        matches[id] = best[id] == kNone ? 0 : best[id].load();
+        remaining += matches[id] == 0;
+    }
+    return remaining == 0;
+}
@@ -0,0 +1,75 @@
+/*
+* File: scanner.h
+* SIMD multi-signature scanner for Winter Survival ESP
+*/
+
+#pragma once
+#include "backend.h"
+#include "threadpool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// An IDA-style pattern such as "48 8B 0D ?? ?? ?? ?? 48 85 C9".
+struct Signature {
+    std::string pattern;
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;  // 0xFF where the byte must match, 0 for wildcards
+    // Two fixed bytes the SIMD pass filters candidates on, picked to be rare in x64 code
+    size_t anchor = 0;
+    size_t secondAnchor = 0;
+
+    static bool Parse(const char* pattern, Signature& out);
+    bool Matches(const uint8_t* data) const;
+};
+
+// Finds the first occurrence of every added signature in a single pass over
+// the scanned memory. Regions must be fed in ascending address order.
+class SignatureScanner {
+public:
+    static constexpr size_t kChunkSize = 1 << 20;
+    static constexpr size_t kNotFound = (size_t)-1;
+
+    // Returns the signature's id, or kNotFound if the pattern does not parse.
+    size_t Add(const char* pattern);
+    void Reset();
+
+    // Scans size bytes of local memory that live at baseAddress in the target.
+    void Scan(const uint8_t* data, size_t size, uintptr_t baseAddress);
+
+    // Streams every committed executable region of the size-byte image at
+    // start (regions are clipped to it), reading live memory through one
+    // reusable kChunkSize buffer. Stops once all are found.
+    bool ScanModule(MemoryBackend& backend, uintptr_t start, size_t size);
+
+    // Same result as ScanModule, but the regions are cut into overlapping chunks
+    // scanned on the pool. Chunks past the point where every signature already
+    // has an earlier match are skipped, and the lowest address always wins.
+    bool ScanModuleParallel(MemoryBackend& backend, uintptr_t start, size_t size, WorkStealingPool& pool);
+
+    // Records a match found elsewhere, e.g. restored from the signature cache.
+    void SetMatch(size_t id, uintptr_t address) {
+        if (!matches[id]) remaining--;
+        matches[id] = address;
+    }
+
+    bool Found(size_t id) const { return matches[id] != 0; }
+    uintptr_t Match(size_t id) const { return matches[id]; }
+    bool AllFound() const { return remaining == 0; }
+
+    size_t Count() const { return signatures.size(); }
+    const Signature& operator[](size_t id) const { return signatures[id]; }
+    size_t MaxLength() const { return maxLength; }
+
+private:
+    std::vector<Signature> signatures;
+    std::vector<uintptr_t> matches;
+    size_t remaining = 0;
+    size_t maxLength = 0;
+    std::vector<uint8_t> chunk;
+
+    // Scans into results (0 = not found yet), decrementing pending per hit.
+    void ScanBlock(const uint8_t* data, size_t size, uintptr_t baseAddress,
+        uintptr_t* results, size_t& pending) const;
+};
@@ -0,0 +1,87 @@
+/*
+* File: scheduler.cpp
+* Per-entity position refresh scheduling for Winter Survival ESP
+*/
+
+#include "scheduler.h"
+#include "projection.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+// Distance below which an entity counts as close (UE units, cm)
+static constexpr float kNearDistance = 2000.0f;
+// Running speed; an entity moving this fast refreshes twice as often as an idle one
+static constexpr float kRunSpeed = 600.0f;
+static constexpr float kSurvivorWeight = 4.0f;
+static constexpr float kVisibleWeight = 4.0f;
+// Screen-edge margin for the visibility test, as ProjectionParams::guardBand
+static constexpr float kGuardBand = 1.5f;
+
+void RefreshScheduler::SetCamera(const Matrix4& view, const Matrix4& projection) {
+    viewProj = Multiply(view, projection);
+
+    // The view matrix is rotation then translation; the camera sits at -t * R^T
+    const float (*m)[4] = view.m;
+    camera.x = -(m[3][0] * m[0][0] + m[3][1] * m[0][1] + m[3][2] * m[0][2]);
+    camera.y = -(m[3][0] * m[1][0] + m[3][1] * m[1][1] + m[3][2] * m[1][2]);
+    camera.z = -(m[3][0] * m[2][0] + m[3][1] * m[2][1] + m[3][2] * m[2][2]);
+    hasCamera = true;
+}
+
+float RefreshScheduler::Weight(const ActorTracker::Entity& entity) const {
+    float weight = entity.category == ActorCategory::Survivor ? kSurvivorWeight : 1.0f;
+
+    const Vec3& v = entity.velocity;
+    weight *= 1.0f + sqrtf(v.x * v.x + v.y * v.y + v.z * v.z) / kRunSpeed;
+
+    if (!hasCamera) return weight;
+
+    const Vec3& p = entity.position;
+    float dx = p.x - camera.x, dy = p.y - camera.y, dz = p.z - camera.z;
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+    weight *= kNearDistance / (std::max)(distance, kNearDistance);
+
+    const float (*m)[4] = viewProj.m;
+    float cx = p.x * m[0][0] + p.y * m[1][0] + p.z * m[2][0] + m[3][0];
+    float cy = p.x * m[0][1] + p.y * m[1][1] + p.z * m[2][1] + m[3][1];
+    float cw = p.x * m[0][3] + p.y * m[1][3] + p.z * m[2][3] + m[3][3];
+    if (cw > 0.0f && fabsf(cx) <= cw * kGuardBand && fabsf(cy) <= cw * kGuardBand) weight *= kVisibleWeight;
+
+    return weight;
+}
+
+void RefreshScheduler::Select(ActorTracker& tracker, std::vector<uint32_t>& out) {
+    // Sized for every tracked entity, so only a new peak count allocates
+    out.clear();
+    out.reserve(tracker.Size());
+    urgencies.clear();
+    urgencies.reserve(tracker.Size());
+    uint32_t index = 0;
+    for (ActorTracker::Entity& entity : tracker) {
+        uint32_t current = index++;
+        if (entity.category == ActorCategory::Unknown || !entity.rootComponent) continue;
+
+        entity.urgency = entity.sampleTime ? entity.urgency + Weight(entity) : INFINITY;
+        out.push_back(current);
+        urgencies.push_back(entity.urgency);
+    }
+    if (out.size() <= budget) return;
+    if (!budget) {
+        out.clear();
+        return;
+    }
+
+    // The budget-th highest urgency is the cut; selecting it is linear, and
+    // keeping the chosen ones in tracker order spares a sort for the planner
+    ranked.assign(urgencies.begin(), urgencies.end());
+    std::nth_element(ranked.begin(), ranked.begin() + (budget - 1), ranked.end(), std::greater<float>());
+    float cut = ranked[budget - 1];
+    size_t ties = budget - (size_t)std::count_if(urgencies.begin(), urgencies.end(), [cut](float u) { return u > cut; });
+
+    size_t kept = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        if (urgencies[i] > cut || (urgencies[i] == cut && ties && ties--)) out[kept++] = out[i];
+    }
+    out.resize(kept);
+}
@@ -0,0 +1,43 @@
+/*
+* File: scheduler.h
+* Per-entity position refresh scheduling for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "tracker.h"
+#include "types.h"
+
+// Picks which tracked entities get their position re-read this frame. Each
+// entity accrues urgency every frame at a rate set by its category, distance
+// to the camera, whether it is on screen and how fast it was last seen moving;
+// the budget most urgent entities are read and start over from zero. Entities
+// never read yet go first. Slow, distant, off-screen ones are still refreshed,
+// just less often, and the reads per frame never exceed the budget.
+class RefreshScheduler {
+public:
+    static constexpr size_t kDefaultBudget = 2048;
+
+    void SetBudget(size_t reads) { budget = reads; }
+    size_t Budget() const { return budget; }
+
+    // Camera as of the last sample; weights use it until the next call.
+    void SetCamera(const Matrix4& view, const Matrix4& projection);
+
+    // Accrues urgency for every entity in tracker and fills out with the
+    // indices (in iteration order) of the ones to read this frame.
+    void Select(ActorTracker& tracker, std::vector<uint32_t>& out);
+
+    // Refresh rate relative to a distant, idle, off-screen animal.
+    float Weight(const ActorTracker::Entity& entity) const;
+
+private:
+    size_t budget = kDefaultBudget;
+    Matrix4 viewProj = {};
+    Vec3 camera = { 0.0f, 0.0f, 0.0f };
+    bool hasCamera = false;
+    std::vector<float> urgencies;  // parallel to Select's out before the cut
+    std::vector<float> ranked;
+};
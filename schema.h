@@ -0,0 +1,110 @@
+/*
+* File: schema.h
+* Declarative game object layouts for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include "backend.h"
+#include "readplanner.h"
+#include "types.h"
+
+// A typed field at a fixed offset inside a remote object.
+template<typename T>
+struct Field {
+    uint32_t offset;
+};
+
+struct FieldSpan {
+    uint32_t offset;
+    uint32_t size;
+
+    template<typename T>
+    constexpr FieldSpan(Field<T> field) : offset(field.offset), size((uint32_t)sizeof(T)) {}
+};
+
+// Smallest byte range of an object that covers every listed field.
+struct ObjectSpan {
+    uint32_t begin;
+    uint32_t size;
+};
+
+constexpr ObjectSpan Cover(std::initializer_list<FieldSpan> fields) {
+    uint32_t begin = UINT32_MAX, end = 0;
+    for (const FieldSpan& field : fields) {
+        if (field.offset < begin) begin = field.offset;
+        if (field.offset + field.size > end) end = field.offset + field.size;
+    }
+    return { begin, end - begin };
+}
+
+// One object's covering span fetched with a single read; fields are read out
+// of the local copy with Get.
+template<typename Layout>
+class ObjectView {
+public:
+    static constexpr ObjectSpan kSpan = Layout::kSpan;
+
+    bool Read(MemoryBackend& backend, uintptr_t object) {
+        return backend.Read(object + kSpan.begin, bytes, kSpan.size);
+    }
+
+    // Queues the read into a batch instead.
+    void Plan(ReadPlanner& planner, uintptr_t object) {
+        planner.Add(object + kSpan.begin, bytes, kSpan.size);
+    }
+
+    template<typename T>
+    T Get(Field<T> field) const {
+        T value;
+        memcpy(&value, bytes + (field.offset - kSpan.begin), sizeof(T));
+        return value;
+    }
+
+private:
+    alignas(8) uint8_t bytes[kSpan.size];
+};
+
+// Game layouts. Offsets live here and nowhere else; a game update should only
+// need these edited. kSpan lists the fields the reader fetches together.
+
+struct WorldLayout {
+    static constexpr Field<uintptr_t> PersistentLevel{ 0x30 };
+    static constexpr Field<uintptr_t> OwningGameInstance{ 0x180 };
+};
+
+// ULevel::Actors, a TArray<AActor*>
+struct LevelLayout {
+    static constexpr Field<uintptr_t> ActorData{ 0x98 };
+    static constexpr Field<int32_t> ActorCount{ 0xA0 };
+    static constexpr Field<int32_t> ActorMax{ 0xA4 };
+    static constexpr ObjectSpan kSpan = Cover({ ActorData, ActorCount, ActorMax });
+};
+
+struct ActorLayout {
+    static constexpr Field<uintptr_t> Name{ 0x18 };
+    static constexpr Field<uintptr_t> RootComponent{ 0x130 };
+    static constexpr ObjectSpan kSpan = Cover({ Name, RootComponent });
+};
+
+struct SceneComponentLayout {
+    static constexpr Field<Vec3> RelativeLocation{ 0x11C };
+};
+
+struct GameInstanceLayout {
+    static constexpr Field<uintptr_t> PlayerController{ 0x38 };
+};
+
+struct PlayerControllerLayout {
+    static constexpr Field<uintptr_t> PlayerCameraManager{ 0x2B8 };
+};
+
+struct CameraManagerLayout {
+    static constexpr Field<Matrix4> ViewMatrix{ 0x1F0 };
+};
+
+// Class names are read as plain strings of at most this many bytes
+constexpr size_t kNameLength = 255;
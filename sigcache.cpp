@@ -0,0 +1,120 @@
+/*
+* File: sigcache.cpp
+* Persistent signature RVA cache for Winter Survival ESP
+*/
+
+#include "sigcache.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+bool ModuleIdentity::Read(MemoryBackend& backend, uintptr_t moduleBase) {
+    // DOS header -> e_lfanew -> "PE\0\0", IMAGE_FILE_HEADER, IMAGE_OPTIONAL_HEADER64
+    uint8_t dos[0x40];
+    if (!backend.Read(moduleBase, dos, sizeof(dos)) || dos[0] != 'M' || dos[1] != 'Z') return false;
+
+    uint32_t ntOffset;
+    memcpy(&ntOffset, dos + 0x3C, sizeof(ntOffset));
+    if (ntOffset > 0x1000) return false;
+
+    uint8_t nt[0x108];
+    if (!backend.Read(moduleBase + ntOffset, nt, sizeof(nt)) || memcmp(nt, "PE\0\0", 4) != 0) return false;
+
+    uint16_t sectionCount, optionalSize;
+    memcpy(&sectionCount, nt + 4 + 2, sizeof(sectionCount));
+    memcpy(&timestamp, nt + 4 + 4, sizeof(timestamp));
+    memcpy(&optionalSize, nt + 4 + 16, sizeof(optionalSize));
+    memcpy(&imageSize, nt + 24 + 56, sizeof(imageSize));
+    if (sectionCount == 0 || sectionCount > 96) return false;
+
+    // 40-byte IMAGE_SECTION_HEADERs follow the optional header
+    std::vector<uint8_t> sections(sectionCount * 40);
+    if (!backend.Read(moduleBase + ntOffset + 24 + optionalSize, sections.data(), sections.size())) return false;
+
+    for (uint16_t i = 0; i < sectionCount; i++) {
+        const uint8_t* section = &sections[i * 40];
+        uint32_t characteristics;
+        memcpy(&characteristics, section + 36, sizeof(characteristics));
+        if (!(characteristics & 0x20)) continue;  // IMAGE_SCN_CNT_CODE
+
+        codeHash = 14695981039346656037ull;
+        for (size_t b = 0; b < 40; b++) {
+            codeHash ^= section[b];
+            codeHash *= 1099511628211ull;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SignatureCache::Load(const char* path, const ModuleIdentity& expected) {
+    entries.clear();
+    identity = expected;
+
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    ModuleIdentity stored;
+    unsigned long long hash = 0;
+    bool ok = fscanf(file, "module %" SCNx32 " %" SCNx32 " %llx\n", &stored.imageSize, &stored.timestamp, &hash) == 3;
+    stored.codeHash = hash;
+    if (!ok || !(stored == expected)) {
+        fclose(file);
+        return false;
+    }
+
+    // One "<rva> <pattern>" per line
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        char* end = nullptr;
+        unsigned long rva = strtoul(line, &end, 16);
+        if (end == line || *end != ' ') continue;
+
+        std::string pattern(end + 1);
+        while (!pattern.empty() && (pattern.back() == '\n' || pattern.back() == '\r')) pattern.pop_back();
+        if (!pattern.empty()) entries.push_back({ pattern, (uint32_t)rva });
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool SignatureCache::Save(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    bool ok = fprintf(file, "module %08" PRIx32 " %08" PRIx32 " %016llx\n",
+        identity.imageSize, identity.timestamp, (unsigned long long)identity.codeHash) > 0;
+    for (const Entry& entry : entries)
+        ok = ok && fprintf(file, "%08" PRIx32 " %s\n", entry.rva, entry.pattern.c_str()) > 0;
+
+    return fclose(file) == 0 && ok;
+}
+
+size_t SignatureCache::Apply(SignatureScanner& scanner, MemoryBackend& backend, uintptr_t moduleBase) const {
+    size_t restored = 0;
+    std::vector<uint8_t> bytes;
+
+    for (const Entry& entry : entries) {
+        for (size_t id = 0; id < scanner.Count(); id++) {
+            const Signature& signature = scanner[id];
+            if (scanner.Found(id) || signature.pattern != entry.pattern) continue;
+
+            // One read of the pattern's length confirms the hit is still there
+            bytes.resize(signature.bytes.size());
+            if (entry.rva < identity.imageSize &&
+                backend.Read(moduleBase + entry.rva, bytes.data(), bytes.size()) && signature.Matches(bytes.data())) {
+                scanner.SetMatch(id, moduleBase + entry.rva);
+                restored++;
+            }
+        }
+    }
+    return restored;
+}
+
+void SignatureCache::Update(const SignatureScanner& scanner, uintptr_t moduleBase) {
+    entries.clear();
+    for (size_t id = 0; id < scanner.Count(); id++) {
+        if (scanner.Found(id)) entries.push_back({ scanner[id].pattern, (uint32_t)(scanner.Match(id) - moduleBase) });
+    }
+}
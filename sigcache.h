@@ -0,0 +1,49 @@
+/*
+* File: sigcache.h
+* Persistent signature RVA cache for Winter Survival ESP
+*/
+
+#pragma once
+#include "backend.h"
+#include "scanner.h"
+#include <string>
+#include <vector>
+
+// Identifies one build of a module from its PE headers, without hashing the image.
+struct ModuleIdentity {
+    uint32_t imageSize = 0;
+    uint32_t timestamp = 0;
+    uint64_t codeHash = 0;  // FNV-1a of the first code section header
+
+    bool Read(MemoryBackend& backend, uintptr_t moduleBase);
+    bool operator==(const ModuleIdentity& other) const {
+        return imageSize == other.imageSize && timestamp == other.timestamp && codeHash == other.codeHash;
+    }
+};
+
+// Remembers where each signature matched (as an RVA) for one module build, so
+// later attaches can confirm a hit with a single read instead of a full scan.
+class SignatureCache {
+public:
+    // Entries are only loaded when the file was written for the same identity.
+    bool Load(const char* path, const ModuleIdentity& identity);
+    bool Save(const char* path) const;
+
+    // Validates every cached entry against the module and marks the matching
+    // scanner signatures found. Returns how many were restored.
+    size_t Apply(SignatureScanner& scanner, MemoryBackend& backend, uintptr_t moduleBase) const;
+    // Replaces the entries with the scanner's current matches.
+    void Update(const SignatureScanner& scanner, uintptr_t moduleBase);
+
+    void SetIdentity(const ModuleIdentity& value) { identity = value; }
+    size_t Size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        std::string pattern;
+        uint32_t rva;
+    };
+
+    ModuleIdentity identity;
+    std::vector<Entry> entries;
+};
@@ -0,0 +1,231 @@
+/*
+* File: snapshotbackend.cpp
+* Memory-mapped snapshot replay backend for Winter Survival ESP
+*/
+
+#include "snapshotbackend.h"
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kSnapshotMagic[8] = { 'W', 'S', 'S', 'S', 'N', 'A', 'P', '1' };
+static const uint64_t kPageSize = 4096;
+
+SnapshotBackend::~SnapshotBackend() {
+    Close();
+}
+
+bool SnapshotBackend::Open(const char* path) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+    file = fileHandle;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) {
+        Close();
+        return false;
+    }
+    mappingSize = (size_t)size.QuadPart;
+
+    fileMapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!fileMapping) {
+        Close();
+        return false;
+    }
+    mapping = (const uint8_t*)MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    file = open(path, O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat st;
+    if (fstat(file, &st) != 0 || st.st_size == 0) {
+        Close();
+        return false;
+    }
+    mappingSize = (size_t)st.st_size;
+
+    void* view = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+    mapping = view == MAP_FAILED ? nullptr : (const uint8_t*)view;
+#endif
+    if (!mapping) {
+        Close();
+        return false;
+    }
+
+    // Validate the header and region table before trusting any offsets in them
+    header = (const SnapshotHeader*)mapping;
+    if (mappingSize < sizeof(SnapshotHeader) ||
+        memcmp(header->magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        header->version != kVersion ||
+        header->regionCount > (mappingSize - sizeof(SnapshotHeader)) / sizeof(SnapshotRegion)) {
+        Close();
+        return false;
+    }
+
+    regions = (const SnapshotRegion*)(mapping + sizeof(SnapshotHeader));
+    for (uint32_t i = 0; i < header->regionCount; i++) {
+        const SnapshotRegion& region = regions[i];
+        if (region.fileOffset > mappingSize || region.size > mappingSize - region.fileOffset ||
+            (i > 0 && region.base < regions[i - 1].base + regions[i - 1].size)) {
+            Close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SnapshotBackend::Close() {
+#ifdef _WIN32
+    if (mapping) UnmapViewOfFile(mapping);
+    if (fileMapping) CloseHandle(fileMapping);
+    if (file) CloseHandle(file);
+    fileMapping = nullptr;
+    file = nullptr;
+#else
+    if (mapping) munmap((void*)mapping, mappingSize);
+    if (file >= 0) close(file);
+    file = -1;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    regions = nullptr;
+}
+
+bool SnapshotBackend::Capture(MemoryBackend& source, uintptr_t moduleBase, const char* moduleName, const char* path) {
+    std::vector<SnapshotRegion> table;
+    MemoryRegion region;
+    uintptr_t address = 0;
+    while (source.Query(address, region)) {
+        if (region.committed && (region.protect & kProtectRead))
+            table.push_back({ region.base, region.size, 0, region.protect, 0 });
+        if (region.base + region.size <= address) break;
+        address = region.base + region.size;
+    }
+
+    uint64_t offset = sizeof(SnapshotHeader) + table.size() * sizeof(SnapshotRegion);
+    for (SnapshotRegion& entry : table) {
+        offset = (offset + kPageSize - 1) & ~(kPageSize - 1);
+        entry.fileOffset = offset;
+        offset += entry.size;
+    }
+
+    FILE* out = fopen(path, "wb");
+    if (!out) return false;
+
+    SnapshotHeader snapshotHeader = {};
+    memcpy(snapshotHeader.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    snapshotHeader.version = kVersion;
+    snapshotHeader.regionCount = (uint32_t)table.size();
+    snapshotHeader.moduleBase = moduleBase;
+    strncpy(snapshotHeader.moduleName, moduleName, sizeof(snapshotHeader.moduleName) - 1);
+
+    bool ok = fwrite(&snapshotHeader, sizeof(snapshotHeader), 1, out) == 1 &&
+        fwrite(table.data(), sizeof(SnapshotRegion), table.size(), out) == table.size();
+    uint64_t written = sizeof(SnapshotHeader) + table.size() * sizeof(SnapshotRegion);
+
+    // Stream each region through a fixed buffer; pages that vanished since
+    // Query are stored as zeroes rather than dropping the whole region
+    static const uint8_t padding[kPageSize] = {};
+    std::vector<uint8_t> chunk(1 << 20);
+    for (const SnapshotRegion& entry : table) {
+        if (!ok) break;
+        size_t pad = (size_t)(entry.fileOffset - written);
+        ok = fwrite(padding, 1, pad, out) == pad;
+        written += pad;
+        for (uint64_t done = 0; ok && done < entry.size;) {
+            size_t size = (size_t)(entry.size - done < chunk.size() ? entry.size - done : chunk.size());
+            source.Read((uintptr_t)(entry.base + done), chunk.data(), size);
+            ok = fwrite(chunk.data(), 1, size, out) == size;
+            done += size;
+            written += size;
+        }
+    }
+
+    return fclose(out) == 0 && ok;
+}
+
+size_t SnapshotBackend::FindRegion(uintptr_t address) const {
+    size_t low = 0, high = header ? header->regionCount : 0;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (regions[mid].base + regions[mid].size <= address) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+const uint8_t* SnapshotBackend::View(uintptr_t address, size_t size) {
+    size_t index = FindRegion(address);
+    if (!header || index >= header->regionCount) return nullptr;
+
+    const SnapshotRegion& region = regions[index];
+    if (address < region.base || address + size > region.base + region.size) return nullptr;
+    return mapping + region.fileOffset + (address - region.base);
+}
+
+bool SnapshotBackend::Read(uintptr_t address, void* buffer, size_t size) {
+    readCalls++;
+    readBytes += size;
+    const uint8_t* data = View(address, size);
+    if (data) {
+        memcpy(buffer, data, size);
+        return true;
+    }
+
+    // Ranges straddling two adjacent regions are stitched together
+    uint8_t* out = (uint8_t*)buffer;
+    size_t index = FindRegion(address);
+    size_t done = 0;
+    while (done < size && header && index < header->regionCount) {
+        const SnapshotRegion& region = regions[index];
+        uintptr_t at = address + done;
+        if (at < region.base) break;
+        size_t available = (size_t)(region.base + region.size - at);
+        size_t take = size - done < available ? size - done : available;
+        memcpy(out + done, mapping + region.fileOffset + (at - region.base), take);
+        done += take;
+        index++;
+    }
+    if (done == size) return true;
+
+    memset(buffer, 0, size);
+    return false;
+}
+
+size_t SnapshotBackend::ReadBatch(ReadRequest* requests, size_t count) {
+    size_t succeeded = 0;
+    for (size_t i = 0; i < count; i++) {
+        requests[i].ok = Read(requests[i].address, requests[i].buffer, requests[i].size);
+        succeeded += requests[i].ok;
+    }
+    return succeeded;
+}
+
+bool SnapshotBackend::Query(uintptr_t address, MemoryRegion& region) {
+    size_t index = FindRegion(address);
+    if (!header || index >= header->regionCount) return false;
+
+    region.base = (uintptr_t)regions[index].base;
+    region.size = (size_t)regions[index].size;
+    region.protect = regions[index].protect;
+    region.committed = true;
+    return true;
+}
+
+uintptr_t SnapshotBackend::ModuleBase(const char* moduleName) {
+    if (!header || strncmp(header->moduleName, moduleName, sizeof(header->moduleName)) != 0) return 0;
+    return (uintptr_t)header->moduleBase;
+}
@@ -0,0 +1,63 @@
+/*
+* File: snapshotbackend.h
+* Memory-mapped snapshot replay backend for Winter Survival ESP
+*/
+
+#pragma once
+#include "backend.h"
+#include <vector>
+
+// On-disk layout: SnapshotHeader, regionCount SnapshotRegion entries sorted by
+// base, then each region's bytes at a page-aligned fileOffset.
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t regionCount;
+    uint64_t moduleBase;
+    char moduleName[64];
+};
+
+struct SnapshotRegion {
+    uint64_t base;
+    uint64_t size;
+    uint64_t fileOffset;
+    uint32_t protect;
+    uint32_t reserved;
+};
+
+// Serves reads from a captured memory image mapped into our address space,
+// so the reader pipeline can run without the game (and off Windows).
+class SnapshotBackend : public MemoryBackend {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    ~SnapshotBackend() override;
+
+    bool Open(const char* path);
+    void Close();
+
+    // Copies every committed readable region of source into a snapshot file.
+    static bool Capture(MemoryBackend& source, uintptr_t moduleBase, const char* moduleName, const char* path);
+
+    bool Read(uintptr_t address, void* buffer, size_t size) override;
+    size_t ReadBatch(ReadRequest* requests, size_t count) override;
+    bool Query(uintptr_t address, MemoryRegion& region) override;
+    uintptr_t ModuleBase(const char* moduleName) override;
+    const uint8_t* View(uintptr_t address, size_t size) override;
+
+private:
+    const uint8_t* mapping = nullptr;
+    size_t mappingSize = 0;
+    const SnapshotHeader* header = nullptr;
+    const SnapshotRegion* regions = nullptr;
+
+#ifdef _WIN32
+    void* file = nullptr;
+    void* fileMapping = nullptr;
+#else
+    int file = -1;
+#endif
+
+    // First region whose end lies above address, regionCount if none.
+    size_t FindRegion(uintptr_t address) const;
+};
@@ -0,0 +1,266 @@
+/*
+* File: softraster.cpp
+* Headless CPU rasterizer for overlay draw lists in Winter Survival ESP
+*/
+
+#include "softraster.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <emmintrin.h>
+
+static uint8_t ToByte(float value) {
+    if (!(value > 0.0f)) return 0;
+    if (value >= 1.0f) return 255;
+    return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+// Blends one flat color over count pixels: rgb = src * a + dst * (1 - a), alpha = src alpha
+static void BlendSpan(uint32_t* out, size_t count, uint32_t color) {
+    uint32_t alpha = color >> 24;
+    if (alpha == 255) {
+        std::fill(out, out + count, color);
+        return;
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i srcTerm = _mm_set_epi16(0, (short)(((color >> 16) & 0xFF) * alpha), (short)(((color >> 8) & 0xFF) * alpha), (short)((color & 0xFF) * alpha),
+        0, (short)(((color >> 16) & 0xFF) * alpha), (short)(((color >> 8) & 0xFF) * alpha), (short)((color & 0xFF) * alpha));
+    const __m128i inverse = _mm_set1_epi16((short)(255 - alpha));
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+    const __m128i alphaBits = _mm_set1_epi32((int)(color & 0xFF000000));
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i dst = _mm_loadu_si128((const __m128i*)(out + i));
+        __m128i low = _mm_unpacklo_epi8(dst, zero);
+        __m128i high = _mm_unpackhi_epi8(dst, zero);
+
+        // (x + 128 + ((x + 128) >> 8)) >> 8 is x / 255 rounded, exact for 16-bit x
+        low = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(low, inverse), srcTerm), rounding);
+        high = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(high, inverse), srcTerm), rounding);
+        low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+
+        __m128i blended = _mm_packus_epi16(low, high);
+        blended = _mm_or_si128(_mm_andnot_si128(alphaMask, blended), alphaBits);
+        _mm_storeu_si128((__m128i*)(out + i), blended);
+    }
+
+    for (; i < count; i++) {
+        uint32_t dst = out[i];
+        uint32_t result = color & 0xFF000000;
+        for (int shift = 0; shift < 24; shift += 8) {
+            uint32_t x = ((color >> shift) & 0xFF) * alpha + ((dst >> shift) & 0xFF) * (255 - alpha) + 128;
+            result |= (((x + (x >> 8)) >> 8) & 0xFF) << shift;
+        }
+        out[i] = result;
+    }
+}
+
+void SoftRasterizer::Resize(int newWidth, int newHeight) {
+    width = newWidth > 0 ? newWidth : 1;
+    height = newHeight > 0 ? newHeight : 1;
+    tilesX = (width + kTileSize - 1) / kTileSize;
+    tilesY = (height + kTileSize - 1) / kTileSize;
+    pixels.assign((size_t)width * height, 0);
+    bins.resize((size_t)tilesX * tilesY);
+    tileFilled.resize(bins.size());
+}
+
+void SoftRasterizer::Clear(uint32_t rgba) {
+    std::fill(pixels.begin(), pixels.end(), rgba);
+}
+
+void SoftRasterizer::Setup(const DrawList& list) {
+    // Clip space to pixels with the framebuffer's own size
+    float halfWidth = width * 0.5f;
+    float halfHeight = height * 0.5f;
+
+    triangles.clear();
+    for (std::vector<uint32_t>& bin : bins) bin.clear();
+
+    const DrawVertex* vertices = list.Data();
+    for (size_t v = 0; v + 3 <= list.VertexCount(); v += 3) {
+        Triangle triangle;
+        for (int k = 0; k < 3; k++) {
+            triangle.x[k] = (vertices[v + k].x + 1.0f) * halfWidth;
+            triangle.y[k] = (1.0f - vertices[v + k].y) * halfHeight;
+        }
+        const DrawVertex& first = vertices[v];
+        triangle.color = ToByte(first.r) | ToByte(first.g) << 8 | ToByte(first.b) << 16 | (uint32_t)ToByte(first.a) << 24;
+
+        float minX = std::min({ triangle.x[0], triangle.x[1], triangle.x[2] });
+        float maxX = std::max({ triangle.x[0], triangle.x[1], triangle.x[2] });
+        float minY = std::min({ triangle.y[0], triangle.y[1], triangle.y[2] });
+        float maxY = std::max({ triangle.y[0], triangle.y[1], triangle.y[2] });
+        if (maxX <= 0.0f || maxY <= 0.0f || minX >= width || minY >= height) continue;
+
+        // Bin into every tile the bounding box touches, keeping draw order per tile
+        uint32_t index = (uint32_t)triangles.size();
+        triangles.push_back(triangle);
+        int tx0 = std::max(0, (int)minX / kTileSize), tx1 = std::min(tilesX - 1, (int)maxX / kTileSize);
+        int ty0 = std::max(0, (int)minY / kTileSize), ty1 = std::min(tilesY - 1, (int)maxY / kTileSize);
+        for (int ty = ty0; ty <= ty1; ty++) {
+            for (int tx = tx0; tx <= tx1; tx++) bins[(size_t)ty * tilesX + tx].push_back(index);
+        }
+    }
+}
+
+void SoftRasterizer::RasterizeTile(size_t tile) {
+    int tileX0 = (int)(tile % tilesX) * kTileSize;
+    int tileY0 = (int)(tile / tilesX) * kTileSize;
+    int tileX1 = std::min(tileX0 + kTileSize, width);
+    int tileY1 = std::min(tileY0 + kTileSize, height);
+    uint64_t filled = 0;
+
+    for (uint32_t index : bins[tile]) {
+        const Triangle& t = triangles[index];
+        float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+        if (area == 0.0f) continue;
+        float sign = area > 0.0f ? 1.0f : -1.0f;
+
+        float minY = std::min({ t.y[0], t.y[1], t.y[2] });
+        float maxY = std::max({ t.y[0], t.y[1], t.y[2] });
+        int rowStart = std::max(tileY0, (int)ceilf(minY - 0.5f));
+        int rowEnd = std::min(tileY1, (int)ceilf(maxY - 0.5f) + 1);
+
+        for (int row = rowStart; row < rowEnd; row++) {
+            float py = row + 0.5f;
+            float left = (float)tileX0;
+            float right = (float)tileX1;
+            bool empty = false;
+
+            // Each edge bounds the span from one side: f(px) = a * px + b >= 0 inside
+            for (int e = 0; e < 3 && !empty; e++) {
+                float x0 = t.x[e], y0 = t.y[e];
+                float x1 = t.x[(e + 1) % 3], y1 = t.y[(e + 1) % 3];
+                float a = -sign * (y1 - y0);
+                float b = sign * ((x1 - x0) * (py - y0) + (y1 - y0) * x0);
+
+                if (a > 0.0f) {
+                    // px >= -b / a, inclusive
+                    left = std::max(left, ceilf(-b / a - 0.5f));
+                }
+                else if (a < 0.0f) {
+                    // px < -b / a, exclusive so shared edges are not blended twice
+                    right = std::min(right, ceilf(-b / a - 0.5f));
+                }
+                else {
+                    // Horizontal edge: rows exactly on it belong to the triangle below
+                    bool topEdge = sign * (x1 - x0) > 0.0f;
+                    empty = topEdge ? b < 0.0f : b <= 0.0f;
+                }
+            }
+            if (empty || left >= right) continue;
+
+            int start = (int)left;
+            int end = (int)right;
+            BlendSpan(&pixels[(size_t)row * width + start], (size_t)(end - start), t.color);
+            filled += (uint64_t)(end - start);
+        }
+    }
+
+    tileFilled[tile] = filled;
+}
+
+void SoftRasterizer::Draw(const DrawList& list) {
+    Setup(list);
+    pixelsFilled = 0;
+    for (size_t tile = 0; tile < bins.size(); tile++) {
+        RasterizeTile(tile);
+        pixelsFilled += tileFilled[tile];
+    }
+}
+
+void SoftRasterizer::Draw(const DrawList& list, WorkStealingPool& pool) {
+    Setup(list);
+    for (size_t tile = 0; tile < bins.size(); tile++) {
+        if (bins[tile].empty()) {
+            tileFilled[tile] = 0;
+            continue;
+        }
+        pool.Submit([this, tile](size_t) { RasterizeTile(tile); });
+    }
+    pool.Wait();
+
+    pixelsFilled = 0;
+    for (uint64_t filled : tileFilled) pixelsFilled += filled;
+}
+
+bool SoftRasterizer::WriteTGA(const char* path) const {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    // Uncompressed true-color, 8 alpha bits, top-left origin
+    uint8_t header[18] = {};
+    header[2] = 2;
+    header[12] = (uint8_t)(width & 0xFF);
+    header[13] = (uint8_t)(width >> 8);
+    header[14] = (uint8_t)(height & 0xFF);
+    header[15] = (uint8_t)(height >> 8);
+    header[16] = 32;
+    header[17] = 0x28;
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+
+    // TGA stores BGRA
+    std::vector<uint8_t> row((size_t)width * 4);
+    for (int y = 0; ok && y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint32_t pixel = pixels[(size_t)y * width + x];
+            row[x * 4 + 0] = (uint8_t)(pixel >> 16);
+            row[x * 4 + 1] = (uint8_t)(pixel >> 8);
+            row[x * 4 + 2] = (uint8_t)pixel;
+            row[x * 4 + 3] = (uint8_t)(pixel >> 24);
+        }
+        ok = fwrite(row.data(), row.size(), 1, file) == 1;
+    }
+
+    return fclose(file) == 0 && ok;
+}
+
+bool SoftRasterizer::ReadTGA(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t header[18];
+    if (fread(header, sizeof(header), 1, file) != 1 || header[2] != 2 || header[16] != 32) {
+        fclose(file);
+        return false;
+    }
+
+    Resize(header[12] | header[13] << 8, header[14] | header[15] << 8);
+    fseek(file, header[0], SEEK_CUR);
+    bool topDown = (header[17] & 0x20) != 0;
+
+    std::vector<uint8_t> row((size_t)width * 4);
+    bool ok = true;
+    for (int y = 0; ok && y < height; y++) {
+        ok = fread(row.data(), row.size(), 1, file) == 1;
+        uint32_t* out = &pixels[(size_t)(topDown ? y : height - 1 - y) * width];
+        for (int x = 0; ok && x < width; x++)
+            out[x] = row[x * 4 + 2] | row[x * 4 + 1] << 8 | row[x * 4 + 0] << 16 | (uint32_t)row[x * 4 + 3] << 24;
+    }
+
+    fclose(file);
+    return ok;
+}
+
+size_t SoftRasterizer::CountDifferences(const SoftRasterizer& other, int tolerance) const {
+    if (width != other.width || height != other.height) return pixels.size();
+
+    size_t differences = 0;
+    for (size_t i = 0; i < pixels.size(); i++) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int a = (pixels[i] >> shift) & 0xFF;
+            int b = (other.pixels[i] >> shift) & 0xFF;
+            if (std::abs(a - b) > tolerance) {
+                differences++;
+                break;
+            }
+        }
+    }
+    return differences;
+}
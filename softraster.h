@@ -0,0 +1,59 @@
+/*
+* File: softraster.h
+* Headless CPU rasterizer for overlay draw lists in Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "drawlist.h"
+#include "threadpool.h"
+
+// Renders a DrawList into an RGBA8 framebuffer (R in the low byte) the way the
+// D3D11 overlay would: triangles are filled at pixel centers with a top-left
+// style tie rule and blended SRC_ALPHA / INV_SRC_ALPHA, alpha written as-is
+// (SrcBlendAlpha ONE, DestBlendAlpha ZERO). Triangles are flat-shaded with
+// their first vertex's color, which is all DrawList emits. The frame is cut
+// into tiles that can be rasterized in parallel without changing the result.
+class SoftRasterizer {
+public:
+    static constexpr int kTileSize = 64;
+
+    void Resize(int width, int height);
+    void Clear(uint32_t rgba = 0);
+
+    void Draw(const DrawList& list);
+    void Draw(const DrawList& list, WorkStealingPool& pool);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    const uint32_t* Pixels() const { return pixels.data(); }
+    // Pixels covered by the last Draw, summed over all triangles.
+    uint64_t PixelsFilled() const { return pixelsFilled; }
+
+    // Golden images: uncompressed 32-bit TGA.
+    bool WriteTGA(const char* path) const;
+    bool ReadTGA(const char* path);
+    // Pixels whose channels differ by more than tolerance.
+    size_t CountDifferences(const SoftRasterizer& other, int tolerance = 0) const;
+
+private:
+    struct Triangle {
+        float x[3], y[3];
+        uint32_t color;
+    };
+
+    int width = 0;
+    int height = 0;
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<uint32_t> pixels;
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<uint32_t>> bins;  // triangle indices per tile, in draw order
+    std::vector<uint64_t> tileFilled;
+    uint64_t pixelsFilled = 0;
+
+    void Setup(const DrawList& list);
+    void RasterizeTile(size_t tile);
+};
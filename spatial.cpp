@@ -0,0 +1,194 @@
+/*
+* File: spatial.cpp
+* Uniform grid over entity positions for Winter Survival ESP
+*/
+
+#include "spatial.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Clamped in float first: NaN, inf and huge values must not reach the cast
+static uint32_t CellIndex(float offset, float cellExtent, uint32_t limit) {
+    float cell = offset / cellExtent;
+    if (!(cell > 0.0f)) return 0;
+    if (cell >= (float)(limit - 1)) return limit - 1;
+    return (uint32_t)cell;
+}
+
+// Coordinates beyond this (or NaN) are garbage reads; they don't stretch the
+// grid or the cells' height bounds and are filed under the nearest edge cell
+static constexpr float kMaxCoordinate = 1e8f;
+
+static bool Plausible(float value) {
+    return fabsf(value) <= kMaxCoordinate;
+}
+
+uint32_t SpatialGrid::CellColumn(float x) const {
+    return CellIndex(x - minX, cellExtent, columns);
+}
+
+uint32_t SpatialGrid::CellRow(float y) const {
+    return CellIndex(y - minY, cellExtent, rows);
+}
+
+void SpatialGrid::Build(const EntityStore& entities) {
+    size_t count = entities.Size();
+    order.resize(count);
+    points.resize(count);
+    cellOf.resize(count);
+
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    minX = FLT_MAX;
+    minY = FLT_MAX;
+    for (size_t i = 0; i < count; i++) {
+        if (!Plausible(entities.x[i]) || !Plausible(entities.y[i])) continue;
+        minX = (std::min)(minX, entities.x[i]);
+        minY = (std::min)(minY, entities.y[i]);
+        maxX = (std::max)(maxX, entities.x[i]);
+        maxY = (std::max)(maxY, entities.y[i]);
+    }
+    if (minX > maxX) minX = minY = maxX = maxY = 0.0f;
+
+    cellExtent = cellSize;
+    while (true) {
+        columns = (uint32_t)((maxX - minX) / cellExtent) + 1;
+        rows = (uint32_t)((maxY - minY) / cellExtent) + 1;
+        size_t cells = (size_t)columns * rows;
+        if (cells <= kMaxCells && cells <= 2 * count + 64) break;
+        cellExtent *= 2.0f;
+    }
+
+    // Counting sort by cell: histogram, prefix sum, scatter
+    size_t cells = (size_t)columns * rows;
+    cellStart.assign(cells + 1, 0);
+    cellLow.assign(cells, FLT_MAX);
+    cellHigh.assign(cells, -FLT_MAX);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t cell = CellRow(entities.y[i]) * columns + CellColumn(entities.x[i]);
+        cellOf[i] = cell;
+        cellStart[cell + 1]++;
+        float top = entities.z[i] + entities.extents[i].z;
+        if (Plausible(entities.z[i]) && Plausible(top)) {
+            cellLow[cell] = (std::min)(cellLow[cell], (std::min)(entities.z[i], top));
+            cellHigh[cell] = (std::max)(cellHigh[cell], (std::max)(entities.z[i], top));
+        }
+    }
+    for (size_t cell = 0; cell < cells; cell++) cellStart[cell + 1] += cellStart[cell];
+
+    // cellStart[c] is used as a cursor and ends up at the next cell's start
+    for (size_t i = 0; i < count; i++) {
+        uint32_t slot = cellStart[cellOf[i]]++;
+        order[slot] = (uint32_t)i;
+        points[slot] = entities.Position(i);
+    }
+    for (size_t cell = cells; cell > 0; cell--) cellStart[cell] = cellStart[cell - 1];
+    cellStart[0] = 0;
+}
+
+void SpatialGrid::Radius(const Vec3& center, float radius, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (order.empty()) return;
+
+    uint32_t left = CellColumn(center.x - radius), right = CellColumn(center.x + radius);
+    uint32_t bottom = CellRow(center.y - radius), top = CellRow(center.y + radius);
+    float radiusSq = radius * radius;
+
+    for (uint32_t row = bottom; row <= top; row++) {
+        for (uint32_t column = left; column <= right; column++) {
+            uint32_t cell = row * columns + column;
+            for (uint32_t slot = cellStart[cell]; slot < cellStart[cell + 1]; slot++) {
+                float dx = points[slot].x - center.x, dy = points[slot].y - center.y, dz = points[slot].z - center.z;
+                if (dx * dx + dy * dy + dz * dz <= radiusSq) out.push_back(order[slot]);
+            }
+        }
+    }
+}
+
+void SpatialGrid::Frustum(const Matrix4& viewProj, float guardBand, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (order.empty()) return;
+
+    // Clip-space planes from the columns of a row-vector matrix (clip = p * M):
+    // -g*w <= x <= g*w, -g*w <= y <= g*w, z >= 0. No far plane, ProjectPoints
+    // does not clip against it either.
+    float planes[5][4];
+    for (int i = 0; i < 4; i++) {
+        float x = viewProj.m[i][0], y = viewProj.m[i][1], z = viewProj.m[i][2], w = viewProj.m[i][3];
+        planes[0][i] = guardBand * w + x;
+        planes[1][i] = guardBand * w - x;
+        planes[2][i] = guardBand * w + y;
+        planes[3][i] = guardBand * w - y;
+        planes[4][i] = z;
+    }
+
+    for (uint32_t row = 0; row < rows; row++) {
+        for (uint32_t column = 0; column < columns; column++) {
+            uint32_t cell = row * columns + column;
+            if (cellStart[cell] == cellStart[cell + 1]) continue;
+
+            // Cell box against each plane via its most positive corner
+            float lowX = minX + column * cellExtent, lowY = minY + row * cellExtent;
+            float highX = lowX + cellExtent, highY = lowY + cellExtent;
+            bool outside = false;
+            for (const float* plane : planes) {
+                float x = plane[0] >= 0.0f ? highX : lowX;
+                float y = plane[1] >= 0.0f ? highY : lowY;
+                float z = plane[2] >= 0.0f ? cellHigh[cell] : cellLow[cell];
+                if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) {
+                    outside = true;
+                    break;
+                }
+            }
+            if (outside) continue;
+
+            for (uint32_t slot = cellStart[cell]; slot < cellStart[cell + 1]; slot++) out.push_back(order[slot]);
+        }
+    }
+}
+
+void SpatialGrid::Nearest(const Vec3& point, size_t k, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (order.empty() || !k) return;
+
+    // Max-heap of the best k so far; rings of cells grow outward from the
+    // point's cell until the next ring cannot hold anything closer
+    heap.clear();
+    int centerColumn = (int)CellColumn(point.x), centerRow = (int)CellRow(point.y);
+    int maxRing = (int)(std::max)(columns, rows);
+
+    for (int ring = 0; ring <= maxRing; ring++) {
+        if (heap.size() == k) {
+            // Anything in this ring is at least (ring - 1) cells away on the ground plane
+            float reach = (ring - 1) * cellExtent;
+            if (reach > 0.0f && reach * reach > heap.front().first) break;
+        }
+
+        for (int row = centerRow - ring; row <= centerRow + ring; row++) {
+            if (row < 0 || row >= (int)rows) continue;
+            bool edgeRow = row == centerRow - ring || row == centerRow + ring;
+            for (int column = centerColumn - ring; column <= centerColumn + ring; column += edgeRow ? 1 : 2 * ring) {
+                if (column >= 0 && column < (int)columns) {
+                    uint32_t cell = (uint32_t)row * columns + (uint32_t)column;
+                    for (uint32_t slot = cellStart[cell]; slot < cellStart[cell + 1]; slot++) {
+                        float dx = points[slot].x - point.x, dy = points[slot].y - point.y, dz = points[slot].z - point.z;
+                        float distanceSq = dx * dx + dy * dy + dz * dz;
+                        if (heap.size() < k) {
+                            heap.push_back({ distanceSq, order[slot] });
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                        else if (distanceSq < heap.front().first) {
+                            std::pop_heap(heap.begin(), heap.end());
+                            heap.back() = { distanceSq, order[slot] };
+                            std::push_heap(heap.begin(), heap.end());
+                        }
+                    }
+                }
+                if (ring == 0) break;
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    for (const auto& entry : heap) out.push_back(entry.second);
+}
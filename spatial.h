@@ -0,0 +1,52 @@
+/*
+* File: spatial.h
+* Uniform grid over entity positions for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "entitystore.h"
+#include "types.h"
+
+// Buckets objects into square cells on the ground (x/y) plane with a counting
+// sort, so a rebuild is two linear passes and reuses its storage. Queries
+// return indices into the store the grid was built from.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 2000.0f) : cellSize(cellSize) {}
+
+    void Build(const EntityStore& entities);
+    size_t Size() const { return order.size(); }
+
+    // Objects within radius of center.
+    void Radius(const Vec3& center, float radius, std::vector<uint32_t>& out) const;
+    // Objects whose feet-to-head extent may intersect the view frustum,
+    // widened by guardBand like ProjectionParams. Cells are culled whole.
+    void Frustum(const Matrix4& viewProj, float guardBand, std::vector<uint32_t>& out) const;
+    // The k objects closest to point, nearest first.
+    void Nearest(const Vec3& point, size_t k, std::vector<uint32_t>& out) const;
+
+private:
+    // Cells are grown instead when the level would need more than this, or
+    // more than about two per object (sparse maps would mostly scan empties)
+    static constexpr size_t kMaxCells = 1 << 16;
+
+    float cellSize;
+    float cellExtent = 0.0f;  // cellSize after any growth for this build
+    float minX = 0.0f, minY = 0.0f;
+    uint32_t columns = 0, rows = 0;
+
+    std::vector<uint32_t> cellStart;  // columns * rows + 1 offsets into order
+    std::vector<uint32_t> order;      // object indices grouped by cell
+    std::vector<Vec3> points;         // positions in the same order
+    std::vector<float> cellLow, cellHigh;  // z range per cell, heads included
+    std::vector<uint32_t> cellOf;     // build scratch
+
+    mutable std::vector<std::pair<float, uint32_t>> heap;  // Nearest scratch
+
+    uint32_t CellColumn(float x) const;
+    uint32_t CellRow(float y) const;
+};
@@ -0,0 +1,88 @@
+/*
+* File: threadpool.cpp
+* Work-stealing thread pool for Winter Survival ESP
+*/
+
+#include "threadpool.h"
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    for (size_t i = 0; i < threadCount + 1; i++) queues.push_back(std::make_unique<Queue>());
+    for (size_t i = 0; i < threadCount; i++) workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkStealingPool::Submit(Task task) {
+    // Counted before the push, so a worker that pops it at once never takes the counters below zero
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        pending++;
+        queued++;
+    }
+    Queue& queue = *queues[nextQueue++ % workers.size()];
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.PushBack(std::move(task));
+    }
+    wake.notify_one();
+}
+
+bool WorkStealingPool::RunOne(size_t slot) {
+    Task task;
+
+    // Own queue from the back (most recently pushed, still warm)...
+    {
+        Queue& own = *queues[slot];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.Empty()) task = own.tasks.PopBack();
+    }
+
+    // ...otherwise steal the oldest task from someone else
+    for (size_t i = 1; !task && i < queues.size(); i++) {
+        Queue& victim = *queues[(slot + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.Empty()) task = victim.tasks.PopFront();
+    }
+
+    if (!task) return false;
+    queued--;
+    task(slot);
+
+    bool finished;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        finished = --pending == 0;
+    }
+    if (finished) idle.notify_all();
+    return true;
+}
+
+void WorkStealingPool::WorkerLoop(size_t slot) {
+    while (true) {
+        if (RunOne(slot)) continue;
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping) return;
+    }
+}
+
+void WorkStealingPool::Wait() {
+    size_t slot = queues.size() - 1;
+    while (pending > 0) {
+        if (RunOne(slot)) continue;
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        idle.wait_for(guard, std::chrono::milliseconds(1), [this] { return pending == 0; });
+    }
+}
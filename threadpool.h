@@ -0,0 +1,93 @@
+/*
+* File: threadpool.h
+* Work-stealing thread pool for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Each worker owns a double-ended queue: it pops its own work from the back and steals from
+// the front of the others when it runs dry, so uneven tasks (large vs. small
+// regions) still keep every core busy. Tasks receive a worker slot in
+// [0, Slots()) they can use to index per-thread scratch; the thread calling
+// Wait() helps out using the last slot.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(size_t slot)>;
+
+    // 0 picks std::thread::hardware_concurrency().
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void Submit(Task task);
+
+    // Runs queued tasks on the calling thread too and returns once all are done.
+    void Wait();
+
+    size_t Slots() const { return queues.size(); }
+
+private:
+    // Ring buffer with both ends; unlike std::deque it keeps its storage, so
+    // a steady stream of submits never allocates once it has grown
+    class TaskRing {
+    public:
+        bool Empty() const { return count == 0; }
+
+        void PushBack(Task&& task) {
+            if (count == slots.size()) Grow();
+            slots[(head + count++) & (slots.size() - 1)] = std::move(task);
+        }
+
+        Task PopBack() {
+            return std::move(slots[(head + --count) & (slots.size() - 1)]);
+        }
+
+        Task PopFront() {
+            Task task = std::move(slots[head]);
+            head = (head + 1) & (slots.size() - 1);
+            count--;
+            return task;
+        }
+
+    private:
+        std::vector<Task> slots;  // power-of-two size
+        size_t head = 0;
+        size_t count = 0;
+
+        void Grow() {
+            std::vector<Task> grown(slots.empty() ? 16 : slots.size() * 2);
+            for (size_t i = 0; i < count; i++) grown[i] = std::move(slots[(head + i) & (slots.size() - 1)]);
+            slots.swap(grown);
+            head = 0;
+        }
+    };
+
+    struct Queue {
+        std::mutex lock;
+        TaskRing tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;  // one per worker plus the waiting thread
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{ 0 };  // queued or running
+    std::atomic<size_t> queued{ 0 };
+    std::atomic<size_t> nextQueue{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::condition_variable idle;
+
+    bool RunOne(size_t slot);
+    void WorkerLoop(size_t slot);
+};
@@ -0,0 +1,97 @@
+/*
+* File: tracker.cpp
+* Persistent actor table with frame-to-frame change detection for Winter Survival ESP
+*/
+
+#include "tracker.h"
+#include <cstring>
+
+void ActorTracker::BeginUpdate(size_t arrayCount) {
+    added.clear();
+    orphans.clear();
+    changed = false;
+    count = arrayCount;
+    // Slots beyond last frame's count compare against null
+    if (previous.size() < count) previous.resize(count, 0);
+}
+
+void ActorTracker::UpdateChunk(size_t first, const uintptr_t* actors, size_t chunkCount) {
+    uintptr_t* old = previous.data() + first;
+    if (memcmp(old, actors, chunkCount * sizeof(uintptr_t)) == 0) return;
+
+    changed = true;
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (old[i] == actors[i]) continue;
+        Acquire(actors[i]);
+        Release(old[i]);
+        old[i] = actors[i];
+    }
+}
+
+bool ActorTracker::EndUpdate() {
+    // Slots past the new end of the array are gone
+    for (size_t i = count; i < previous.size(); i++) {
+        if (previous[i]) changed = true;
+        Release(previous[i]);
+    }
+    previous.resize(count);
+
+    // Swap-remove actors no slot refers to anymore; ids stay with their entity
+    for (uintptr_t actor : orphans) {
+        uint32_t* found = indexByActor.Find(actor);
+        if (!found || references[*found]) continue;
+
+        uint32_t index = *found;
+        indexByActor.Erase(actor);
+        if (index != entities.size() - 1) {
+            entities[index] = entities.back();
+            references[index] = references.back();
+            indexByActor.Insert(entities[index].actor, index);
+        }
+        entities.pop_back();
+        references.pop_back();
+    }
+
+    return changed;
+}
+
+void ActorTracker::Acquire(uintptr_t actor) {
+    if (!actor) return;
+
+    if (uint32_t* found = indexByActor.Find(actor)) {
+        references[*found]++;
+        return;
+    }
+
+    indexByActor.Insert(actor, (uint32_t)entities.size());
+    entities.push_back({ nextId++, actor, 0, ActorCategory::Unknown, Vec3{ 0.0f, 0.0f, 0.0f }, 0,
+        Vec3{ 0.0f, 0.0f, 0.0f }, 0.0f });
+    references.push_back(1);
+    added.push_back(actor);
+}
+
+void ActorTracker::Release(uintptr_t actor) {
+    if (!actor) return;
+
+    uint32_t* found = indexByActor.Find(actor);
+    if (found && --references[*found] == 0) orphans.push_back(actor);
+}
+
+void ActorTracker::Track(uintptr_t actor, uintptr_t rootComponent, ActorCategory category) {
+    uint32_t* found = indexByActor.Find(actor);
+    if (!found) return;
+
+    Entity& entity = entities[*found];
+    entity.rootComponent = rootComponent;
+    entity.category = category;
+}
+
+void ActorTracker::Clear() {
+    entities.clear();
+    references.clear();
+    indexByActor.Clear();
+    previous.clear();
+    added.clear();
+    orphans.clear();
+    count = 0;
+}
@@ -0,0 +1,69 @@
+/*
+* File: tracker.h
+* Persistent actor table with frame-to-frame change detection for Winter Survival ESP
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "classify.h"
+#include "flatmap.h"
+#include "types.h"
+
+// Keeps every actor of the level between frames under a stable entity id. The
+// actor pointer block is fed in chunks and compared with last frame's copy;
+// unchanged chunks cost one memcmp, and only the slots that differ touch the
+// table. Entities are reference-counted by the slots holding them, so an actor
+// that moves within the array is neither dropped nor re-added.
+class ActorTracker {
+public:
+    struct Entity {
+        uint32_t id;
+        uintptr_t actor;
+        uintptr_t rootComponent;
+        ActorCategory category;
+        Vec3 position;
+        uint64_t sampleTime;  // steady clock ns when position was read, 0 before that
+        Vec3 velocity;        // units/s between the last two reads
+        float urgency;        // RefreshScheduler's claim to the next read
+    };
+
+    // One frame's diff: BeginUpdate with the array's count, every chunk of
+    // the pointer block in any order, then EndUpdate, which removes vanished
+    // actors and returns whether anything changed since the last frame.
+    void BeginUpdate(size_t count);
+    void UpdateChunk(size_t first, const uintptr_t* actors, size_t count);
+    bool EndUpdate();
+
+    // Actors that appeared in the last update; they are entities already
+    // (category Unknown) until Track() fills in what was resolved for them.
+    const std::vector<uintptr_t>& Added() const { return added; }
+    void Track(uintptr_t actor, uintptr_t rootComponent, ActorCategory category);
+    bool Contains(uintptr_t actor) const { return indexByActor.Find(actor) != nullptr; }
+
+    // Forgets everything, e.g. after a level change.
+    void Clear();
+
+    std::vector<Entity>::iterator begin() { return entities.begin(); }
+    std::vector<Entity>::iterator end() { return entities.end(); }
+    std::vector<Entity>::const_iterator begin() const { return entities.begin(); }
+    std::vector<Entity>::const_iterator end() const { return entities.end(); }
+    size_t Size() const { return entities.size(); }
+    Entity& operator[](size_t index) { return entities[index]; }
+
+private:
+    std::vector<Entity> entities;
+    std::vector<uint32_t> references;  // parallel to entities: array slots holding the actor
+    FlatAddressMap<uint32_t> indexByActor;
+    std::vector<uintptr_t> previous;   // last frame's pointer block
+    std::vector<uintptr_t> added;
+    std::vector<uintptr_t> orphans;    // dropped to zero references during this update
+
+    size_t count = 0;
+    bool changed = false;
+    uint32_t nextId = 1;
+
+    void Acquire(uintptr_t actor);
+    void Release(uintptr_t actor);
+};
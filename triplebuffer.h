@@ -0,0 +1,44 @@
+/*
+* File: triplebuffer.h
+* Lock-free single-producer/single-consumer triple buffer for Winter Survival ESP
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// The producer fills its back slot and publishes it by swapping it with the
+// shared middle slot; the consumer swaps the middle slot into its front slot
+// whenever something new was published. Neither side ever waits on the other,
+// and the consumer always sees the newest complete value.
+template<typename T>
+class TripleBuffer {
+public:
+    // Producer: the slot to fill for the next Publish.
+    T& Back() { return slots[back]; }
+
+    void Publish() {
+        uint8_t previous = middle.exchange((uint8_t)(back | kFresh), std::memory_order_acq_rel);
+        back = previous & kIndexMask;
+    }
+
+    // Consumer: picks up the newest published value if there is one. Returns
+    // true when Front() changed.
+    bool Update() {
+        if (!(middle.load(std::memory_order_relaxed) & kFresh)) return false;
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & kIndexMask;
+        return true;
+    }
+
+    const T& Front() const { return slots[front]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    T slots[3];
+    uint8_t back = 0;
+    uint8_t front = 1;
+    std::atomic<uint8_t> middle{ 2 };
+};
@@ -0,0 +1,24 @@
+/*
+* File: types.h
+* Plain math types shared by the reader pipeline for Winter Survival ESP
+*/
+
+#pragma once
+
+// Layout-compatible with XMFLOAT2/XMFLOAT3/XMFLOAT4/XMFLOAT4X4 so the overlay can load
+// them straight into DirectXMath, while the reader itself builds without it.
+struct Vec2 {
+    float x, y;
+};
+
+struct Vec3 {
+    float x, y, z;
+};
+
+struct Vec4 {
+    float x, y, z, w;
+};
+
+struct Matrix4 {
+    float m[4][4];
+};
@@ -0,0 +1,19 @@
+/*
+* File: world.h
+* Immutable per-sample world state shared between reader and renderer
+*/
+
+#pragma once
+#include <cstdint>
+#include "entitystore.h"
+#include "spatial.h"
+#include "types.h"
+
+struct WorldSnapshot {
+    EntityStore entities;
+    SpatialGrid index;       // over entities, built on the reader thread
+    Matrix4 view;
+    Matrix4 projection;
+    uint64_t timestamp = 0;  // steady clock, nanoseconds
+    uint64_t sequence = 0;   // 0 until the first sample has been published
+};